@@ -43,39 +43,47 @@ void _subroutine(void) {
   *pDoes = (cell_t)*ip++;
 }
 
+/******************************************************************************/
+/** Loop Frames                                                              **/
+/**   enterLoop() saves the frame of the enclosing loop on the return stack  **/
+/**   and starts a new one, exitLoop() brings the saved one back. See        **/
+/**   loopLimit. The control-flow stack checks the nesting at compile time,  **/
+/**   so nothing else goes on the return stack.                              **/
+/******************************************************************************/
+void enterLoop(cell_t limit, cell_t index) {
+  rPush(loopIndex);
+  rPush(loopLimit);
+  loopLimit = (ucell_t)limit + LOOP_BIAS;
+  loopIndex = (ucell_t)index - loopLimit;
+}
+
+void exitLoop(void) {
+  loopLimit = rPop();
+  loopIndex = rPop();
+}
+
 const PROGMEM char do_sys_str[] = "do-sys";
-// ( n1|u1 n2|u2 -- ) (R: -- loop_sys )
+// ( n1|u1 n2|u2 -- ) (R: -- loop-sys )
 // Set up loop control parameters with index n2|u2 and limit n1|u1. An ambiguous
 // condition exists if n1|u1 and n2|u2 are not the same type. Anything already
 // on the return stack becomes unavailable until the loop-control parameters
 // are discarded.
 void _do_sys(void) {
-  rPush(LOOP_SYS);
-  rPush(pop());   // push index on to return stack
-  rPush(pop());   // push limit on to return stack
+  cell_t index = pop();
+  enterLoop(pop(), index);
 }
 
 const PROGMEM char loop_sys_str[] = "loop-sys";
-// ( n1|u1 n2|u2 -- ) (R: -- loop_sys )
-// Set up loop control parameters with index n2|u2 and limit n1|u1. An ambiguous
-// condition exists if n1|u1 and n2|u2 are not the same type. Anything already
-// on the return stack becomes unavailable until the loop-control parameters
-// are discarded.
+// ( -- ) (R: loop-sys1 -- | loop-sys2 )
+// Add one to the loop index. If the loop index is then equal to the loop limit,
+// discard the loop parameters and continue execution immediately following the
+// loop. Otherwise continue execution at the beginning of the loop.
 void _loop_sys(void) {
-  cell_t limit = rPop();    // fetch limit
-  cell_t index = rPop();    // fetch index
-  index++;
-  if (limit - index) {
-    rPush(index);
-    rPush(limit);
+  if (++loopIndex != LOOP_BIAS) {
     ip = (cell_t*)*ip;
   } else {
     ip++;
-    if (rPop() != LOOP_SYS) {
-      push(-22);
-      _throw();
-      return;
-    }
+    exitLoop();
   }
 }
 
@@ -85,40 +93,147 @@ const PROGMEM char leave_sys_str[] = "leave-sys";
 // if they are unavailable. Continue execution immediately following the
 // innermost syntactically enclosing DO ... LOOP or DO ... +LOOP.
 void _leave_sys(void) {
-  rPop();    // fetch limit
-  rPop();    // fetch index
-  if (rPop() != LOOP_SYS) {
-    push(-22);
-    _throw();
-    return;
-  }
+  exitLoop();
   ip = (cell_t*)*ip;
 }
 
 const PROGMEM char plus_loop_sys_str[] = "plus_loop-sys";
-// ( n1|u1 n2|u2 -- ) (R: -- loop_sys )
-// Set up loop control parameters with index n2|u2 and limit n1|u1. An ambiguous
-// condition exists if n1|u1 and n2|u2 are not the same type. Anything already
-// on the return stack becomes unavailable until the loop-control parameters
-// are discarded.
+// ( n -- ) (R: loop-sys1 -- | loop-sys2 )
+// Add n to the loop index. If the loop index did not cross the boundary between
+// the loop limit minus one and the loop limit, continue execution at the
+// beginning of the loop. Otherwise, discard the current loop control parameters
+// and continue execution immediately following the loop. With the biased
+// index the boundary is where the addition overflows.
 void _plus_loop_sys(void) {
-  cell_t limit = rPop();    // fetch limit
-  cell_t index = rPop();    // fetch index
-  index += pop();
-  if (limit > index) {
-    rPush(index);
-    rPush(limit);
+  ucell_t n = pop();
+  ucell_t index = loopIndex + n;
+  if ((cell_t)((loopIndex ^ index) & (n ^ index)) >= 0) {
+    loopIndex = index;
     ip = (cell_t*)*ip;
   } else {
     ip++;
-    if (rPop() != LOOP_SYS) {
-      push(-22);
-      _throw();
-      return;
-    }
+    exitLoop();
+  }
+}
+
+/******************************************************************************/
+/**                  Fused Primitives (Superinstructions)                    **/
+/**  Substituted by compileWord() for the sequence in each comment. They are **/
+/**  hidden from searches and only appear in compiled code.                  **/
+/******************************************************************************/
+const PROGMEM char lit_plus_str[] = "lit+";
+// literal + ( x1 -- x2 )
+void _lit_plus(void) {
+  TOP += *ip++;
+}
+
+const PROGMEM char fetch_plus_str[] = "@+";
+// @ + ( n a-addr -- n2 )
+void _fetch_plus(void) {
+  NOS += *(cell_t*)TOP;
+  tos--;
+}
+
+const PROGMEM char r_fetch_fetch_str[] = "r@@";
+// r@ @ ( -- x ) (R: a-addr -- a-addr )
+void _r_fetch_fetch(void) {
+  if (rtos < 0) {
+    push(-6);
+    _throw();
+    return;
+  }
+  PUSH(*(cell_t*)rStack[rtos]);
+}
+
+const PROGMEM char dup_zjump_str[] = "dup-zjump";
+// dup zjump ( x -- x )
+void _dup_zjump(void) {
+  if (!TOP) ip = (cell_t*)((size_t)ip + *ip);
+  else ip++;
+}
+
+const PROGMEM char lit_eq_zjump_str[] = "lit=-zjump";
+// literal = zjump ( x -- )
+void _lit_eq_zjump(void) {
+  cell_t n = *ip++;
+  if (stack[tos--] != n) ip = (cell_t*)((size_t)ip + *ip);
+  else ip++;
+}
+
+const PROGMEM char over_eq_zjump_str[] = "over=-zjump";
+// over = zjump ( x1 x2 -- x1 )
+void _over_eq_zjump(void) {
+  cell_t x2 = TOP;
+  tos--;
+  if (TOP != x2) ip = (cell_t*)((size_t)ip + *ip);
+  else ip++;
+}
+
+const PROGMEM char lit_of_str[] = "lit-of";
+// literal over = zjump ( x -- x )
+void _lit_of(void) {
+  cell_t n = *ip++;
+  if (TOP != n) ip = (cell_t*)((size_t)ip + *ip);
+  else ip++;
+}
+
+const PROGMEM char qdo_sys_str[] = "?do-sys";
+// ( n1|u1 n2|u2 -- ) (R: -- | loop-sys )
+// If n1|u1 is equal to n2|u2, continue execution at the location following the
+// loop. Otherwise set up loop control parameters like do-sys.
+void _qdo_sys(void) {
+  cell_t index = pop();
+  cell_t limit = pop();
+  if (index == limit) {
+    ip = (cell_t*)*ip;
+  } else {
+    ip++;
+    enterLoop(limit, index);
   }
 }
 
+const PROGMEM char for_sys_str[] = "for-sys";
+// ( u -- ) (R: -- | loop-sys )
+// If u is zero, continue execution at the location following the loop.
+// Otherwise set up loop control parameters that count the index from u-1 down
+// to zero.
+void _for_sys(void) {
+  cell_t count = pop();
+  if (count == 0) {
+    ip = (cell_t*)*ip;
+  } else {
+    ip++;
+    enterLoop(0, count - 1);
+  }
+}
+
+const PROGMEM char next_sys_str[] = "next-sys";
+// ( -- ) (R: loop-sys1 -- | loop-sys2 )
+// If the loop index is zero, discard the loop control parameters and continue
+// execution immediately following the loop. Otherwise subtract one from the
+// index and continue execution at the beginning of the loop.
+void _next_sys(void) {
+  if (loopIndex-- != LOOP_BIAS) {
+    ip = (cell_t*)*ip;
+  } else {
+    ip++;
+    exitLoop();
+  }
+}
+
+const PROGMEM char forget_sys_str[] = "forget-sys";
+// ( xt -- )
+// Run-time of a MARKER: remove the word xt and every word defined after it.
+void _forget_sys(void) {
+  userEntry_t* e = xtToEntry(pop());
+  if (pTask) {                 // Only the operator may give space back
+    push(-21);
+    _throw();
+    return;
+  }
+  if (e) forgetEntry(e);
+}
+
 /*******************************************************************************/
 /**                          Core Forth Words                                 **/
 /*******************************************************************************/
@@ -126,8 +241,8 @@ const PROGMEM char store_str[] = "!";
 // ( x a-addr --)
 // Store x at a-addr
 void _store(void) { 
-  cell_t* address = (cell_t*)pop();
-  *address = pop();
+  *(cell_t*)TOP = NOS;
+  tos -= 2;
 }
 
 const PROGMEM char number_sign_str[] = "#";
@@ -137,8 +252,8 @@ const PROGMEM char number_sign_str[] = "#";
 // pictured numeric output string.
 void _number_sign(void) { 
   udcell_t ud;
-  ud = (udcell_t)pop() << sizeof(ucell_t) * 8;
-  ud += (udcell_t)pop();
+  ud = (udcell_t)(ucell_t)pop() << sizeof(ucell_t) * 8;
+  ud += (ucell_t)pop();
   *--pPNO = pgm_read_byte(&charset[ud % base]);
   ud /= base;
   push((ucell_t)ud);
@@ -161,8 +276,8 @@ const PROGMEM char number_sign_s_str[] = "#s";
 // ( ud1 -- ud2)
 void _number_sign_s(void) {
   udcell_t ud;
-  ud = (udcell_t)pop() << sizeof(ucell_t) * 8;
-  ud += (udcell_t)pop();
+  ud = (udcell_t)(ucell_t)pop() << sizeof(ucell_t) * 8;
+  ud += (ucell_t)pop();
   while (ud) {
     *--pPNO = pgm_read_byte(&charset[ud % base]);
     ud /= base;
@@ -182,7 +297,7 @@ void _tick(void) {
 //    _find();
 //    pop();
   if (getToken()) {
-    if (isWord(cTokenBuffer)) {
+    if (isWord(cpToken, tokenLength)) {
       push(w);
       return; 
     }
@@ -197,14 +312,15 @@ const PROGMEM char paren_str[] = "(";
 void _paren(void) {
   push(')');
   _word();
-  _drop();
+  pop();
 }
 
 const PROGMEM char star_str[] = "*";
 // ( n1|u1 n2|u2 -- n3|u3 )
 // multiply n1|u1 by n2|u2 giving the product n3|u3
 void _star(void) {
-  push(pop() * pop());
+  NOS *= TOP;
+  tos--;
 }
 
 const PROGMEM char star_slash_str[] = "*/";
@@ -236,9 +352,8 @@ const PROGMEM char plus_str[] = "+";
 // ( n1|u1 n2|u2 -- n3|u3 )
 // add n2|u2 to n1|u1, giving the sum n3|u3
 void _plus(void) {
-  cell_t x = pop();
-  cell_t y = pop();
-  push(x +  y);
+  NOS += TOP;
+  tos--;
 }
 
 const PROGMEM char plus_store_str[] = "+!";
@@ -269,22 +384,7 @@ const PROGMEM char plus_loop_str[] = "+loop";
 // of the loop. Otherwise, discard the current loop control parameters and
 // continue execution immediately following the loop.
 void _plus_loop(void) {
-  *pHere++ = PLUS_LOOP_SYS_IDX;
-  cell_t start_addr = pop();
-  *pHere++ = start_addr;
-  cell_t* ptr = start_addr;
-  cell_t stop_addr = pHere;
-  do {
-    if (*ptr++ == LEAVE_SYS_IDX) {
-      if (*ptr == 0) {
-        *ptr = stop_addr;
-      }
-    }
-  } while (ptr != stop_addr);
-  if ( pop() != DO_SYS) {
-    push(-22);
-    _throw();
-  }
+  closeLoop(PLUS_LOOP_SYS_IDX, DO_SYS);
 }
 
 const PROGMEM char comma_str[] = ",";
@@ -300,8 +400,8 @@ static void _comma(void) {
 const PROGMEM char minus_str[] = "-";
 // ( n1|u1 n2|u2 -- n3|u3 )
 void _minus(void) {
-  cell_t temp = pop();
-  push(pop() -  temp);
+  NOS -= TOP;
+  tos--;
 }
 
 const PROGMEM char dot_str[] = ".";
@@ -319,8 +419,7 @@ const PROGMEM char dot_quote_str[] = ".\x22";
 // Run-Time ( -- )
 // Display ccc.
 void _dot_quote(void) {
-  uint8_t i;
-  char length;
+  uint8_t length;
   if (flags & EXECUTE) {
     Serial.print((char*)ip); // Print the string at the istuction pointer (ip)
     cell_t len = strlen((char*)ip) + 1;  // include null terminator
@@ -329,15 +428,15 @@ void _dot_quote(void) {
   }
   else if (state) {
     cDelimiter = '"';
-    if (!getToken()) {
+    if (!parseToken()) {
       push(-16);
       _throw();
     }
-    length = strlen(cTokenBuffer);
+    length = tokenLength;
     *pHere++ = DOT_QUOTE_IDX;
     char *ptr = (char *) pHere;
     for (uint8_t i = 0; i < length; i++) {
-      *ptr++ = cTokenBuffer[i];
+      *ptr++ = cpToken[i];
     }
     *ptr++ = '\0';    // Terminate String
     pHere = (cell_t *)ptr;
@@ -350,11 +449,11 @@ const PROGMEM char slash_str[] = "/";
 // ( n1 n2 -- n3 )
 // divide n1 by n2 giving a single cell quotient n3
 void _slash(void) {
-  cell_t temp = pop();
-  if (temp)
-    push(pop() /  temp);
-  else {
-    push(-10);
+  if (TOP) {
+    NOS /= TOP;
+    tos--;
+  } else {
+    TOP = -10;
     _throw();
   }
 }
@@ -378,30 +477,28 @@ const PROGMEM char zero_less_str[] = "0<";
 // ( n -- flag )
 // flag is true if and only if n is less than zero.
 void _zero_less(void) {
-  if (pop() < 0) push(TRUE);
-  else push(FALSE);
+  TOP = (TOP < 0) ? TRUE : FALSE;
 }
 
 const PROGMEM char zero_equal_str[] = "0=";
 // ( n -- flag )
 // flag is true if and only if n is equal to zero.
 void _zero_equal(void) {
-  if (pop() == 0) push(TRUE);
-  else push(FALSE);
+  TOP = (TOP == 0) ? TRUE : FALSE;
 }
 
 const PROGMEM char one_plus_str[] = "1+";
 // ( n1|u1 -- n2|u2 )
 // add one to n1|u1 giving sum n2|u2.
 void _one_plus(void) {
-  push(pop() + 1);
+  TOP++;
 }
 
 const PROGMEM char one_minus_str[] = "1-";
 // ( n1|u1 -- n2|u2 )
 // subtract one to n1|u1 giving sum n2|u2.
 void _one_minus(void) {
-  push(pop() - 1);
+  TOP--;
 }
 
 const PROGMEM char two_store_str[] = "2!";
@@ -423,14 +520,14 @@ const PROGMEM char two_star_str[] = "2*";
 // ( x1 -- x2 )
 // x2 is the result of shifting x1 one bit to toward the MSB
 void _two_star(void) {
-  push(pop() << 1);
+  TOP <<= 1;
 }
 
 const PROGMEM char two_slash_str[] = "2/";
 // ( x1 -- x2 )
 // x2 is the result of shifting x1 one bit to toward the LSB
 void _two_slash(void) {
-  push(pop() >> 1);
+  TOP >>= 1;
 }
 
 const PROGMEM char two_fetch_str[] = "2@";  // \x40 == '@'
@@ -447,8 +544,7 @@ void _two_fetch(void) {
 const PROGMEM char two_drop_str[] = "2drop";
 // ( x1 x2 -- )
 static void _two_drop(void) {
-  pop();
-  pop();
+  tos -= 2;
 }
 
 const PROGMEM char two_dup_str[] = "2dup";
@@ -508,8 +604,8 @@ void _semicolon(void) {
 const PROGMEM char lt_str[] = "<";
 // ( n1 n2 -- flag )
 void _lt(void) {
-  if (pop() > pop()) push(TRUE);
-  else push(FALSE);
+  NOS = (NOS < TOP) ? TRUE : FALSE;
+  tos--;
 }
 
 const PROGMEM char lt_number_sign_str[] = "<#";
@@ -525,16 +621,16 @@ const PROGMEM char eq_str[] = "=";
 // ( x1 x2 -- flag )
 // flag is true if and only if x1 is bit for bit the same as x2
 void _eq(void) {
-  if (pop() == pop()) push(TRUE);
-  else push(FALSE);
+  NOS = (NOS == TOP) ? TRUE : FALSE;
+  tos--;
 }
 
 const PROGMEM char gt_str[] = ">";
 // ( n1 n2 -- flag )
 // flag is true if and only if n1 is greater than n2
 void _gt(void) {
-  if (pop() < pop()) push(TRUE);
-  else push(FALSE);
+  NOS = (NOS > TOP) ? TRUE : FALSE;
+  tos--;
 }
 
 const PROGMEM char to_body_str[] = ">body";
@@ -571,44 +667,15 @@ const PROGMEM char to_number_str[] = ">number";
 // converted.  u2 is the number of unconverted characters in the string.  An
 // ambiguous condition exists if ud2 overflows during the conversion.
 void _to_number(void) {
-  uint8_t len;
-  char* ptr;
-  cell_t accum;
-
-  unsigned char negate = 0;                  // flag if number is negative
-  len = (uint8_t)pop();
-  ptr = (char*)pop();
-  accum = pop();
-  
-  // Look at the initial character, handling either '-', '$', or '%'
-  switch (*ptr) {
-    case '$':  base = HEXIDECIMAL; goto SKIP;
-    case '%':  base = BINARY; goto SKIP;
-    case '#':  base = DECIMAL; goto SKIP;
-    case '+':  negate = 0; goto SKIP;
-    case '-':  negate = 1;
-SKIP:                // common code to skip initial character
-    ptr++;
-    break;
-  }
-  // Iterate over rest of string, and if rest of digits are in
-  // the valid set of characters, accumulate them.  If any
-  // invalid characters found, abort and return 0.
-  while (len < 0) {
-    PGM_P pos = strchr_P(charset, (int)tolower(*ptr));
-    cell_t offset = pos - charset;
-    if ((offset < base) && (offset > -1))  
-      accum = (accum * base) + (pos - charset);
-    else {
-      break;           // exit, We hit a non number
-    }
-    ptr++;
-    len--;
-  }
-  if (negate) accum = ~accum + 1;     // apply sign, if necessary
-  push(accum); // Push the resultant number
-  push((size_t)ptr); // Push the last convertered caharacter
-  push(len); // push the remading length of unresolved charaters
+  ucell_t length = pop();
+  const char* ptr = (const char*)pop();
+  ucell_t high = pop();
+  udcell_t ud = ((udcell_t)high << CELL_BITS) | (ucell_t)pop();
+  const char* end = toNumber(&ud, ptr, ptr + length, base);
+  push((cell_t)ud);
+  push((cell_t)(ud >> CELL_BITS));
+  push((size_t)end);
+  push(ptr + length - end);
 }
 
 const PROGMEM char to_r_str[] = ">r";
@@ -632,8 +699,7 @@ const PROGMEM char fetch_str[] = "@";
 // ( a-addr -- x1 )
 // Fetch cell x1 at a-addr.
 void _fetch(void) {
-  cell_t* address = (cell_t*)pop();
-  push(*address);
+  TOP = *(cell_t*)TOP;
 }
 
 const PROGMEM char abort_str[] = "abort";
@@ -670,8 +736,7 @@ const PROGMEM char abs_str[] = "abs";
 // ( n -- u)
 // u is the absolute value of n 
 void _abs(void) {
-  cell_t n = pop();
-  push(n < 0 ? 0 - n : n);
+  if (TOP < 0) TOP = -TOP;
 }
 
 const PROGMEM char accept_str[] = "accept";
@@ -705,10 +770,10 @@ const PROGMEM char allot_str[] = "allot";
 // than zero, release |n| address units of data space. If n is zero, leave the
 // data-space pointer unchanged.
 void _allot(void) {
-  cell_t* pNewHere = pHere + pop();
+  cell_t* pNewHere = (cell_t*)((size_t)pHere + pop());
   // Check that the new pHere is not outside of the forth space
   if (pNewHere >= &forthSpace[0] &&
-      pNewHere < &forthSpace[FORTH_SIZE]) {
+      pNewHere < (cell_t*)pNames) {
     pHere = pNewHere;      // Save the valid address
   } else {                 // Throw an exception
     push(-9);
@@ -720,7 +785,8 @@ const PROGMEM char and_str[] = "and";
 // ( x1 x2 -- x3 )
 // x3 is the bit by bit logical and of x1 with x2
 void _and(void) {
-  push(pop() & pop());
+  NOS &= TOP;
+  tos--;
 }
 
 const PROGMEM char base_str[] = "base";
@@ -751,8 +817,8 @@ void _bl(void) {
 const PROGMEM char c_store_str[] = "c!";
 // ( char c-addr -- )
 void _c_store(void) {
-  uint8_t *addr = (uint8_t*) pop();
-  *addr = (uint8_t)pop();
+  *(uint8_t*)TOP = (uint8_t)NOS;
+  tos -= 2;
 }
 
 const PROGMEM char c_comma_str[] = "c,";
@@ -764,21 +830,20 @@ void _c_comma(void) {
 const PROGMEM char c_fetch_str[] = "c@";
 // ( c-addr -- char )
 void _c_fetch(void) {
-  uint8_t *addr = (uint8_t *) pop();
-  push(*addr);
+  TOP = *(uint8_t*)TOP;
 }
 
 const PROGMEM char cell_plus_str[] = "cell+";
 // ( a-addr1 -- a-addr2 )
 void _cell_plus(void) {
-  push((size_t)(pop() + sizeof(cell_t)));
+  TOP += sizeof(cell_t);
 }
 
 const PROGMEM char cells_str[] = "cells";
 // ( n1 -- n2 )
 // n2 is the size in address units of n1 cells.
 void _cells(void) {
-  push(pop()*sizeof(cell_t));
+  TOP *= sizeof(cell_t);
 }
 
 const PROGMEM char char_str[] = "char";
@@ -797,7 +862,7 @@ void _char(void) {
 const PROGMEM char char_plus_str[] = "char+";
 // ( c-addr1 -- c-addr2 )
 void _char_plus(void) {
-  push(pop() + 1);
+  TOP++;
 }
 
 const PROGMEM char chars_str[] = "chars";
@@ -848,8 +913,10 @@ const PROGMEM char create_str[] = "create";
 void _create(void) {
   openEntry();
   *pHere++ = LITERAL_IDX;
-  // Location of Data Field at the end of the definition.
-  *pHere++ = (size_t)pHere + 2 * sizeof(cell_t);
+  // Location of Data Field at the end of the definition, after the EXIT
+  // below and the one closeEntry() adds.
+  *pHere = (size_t)(pCodeStart + CREATE_BODY);
+  pHere++;
   *pHere = EXIT_IDX;   // Store an extra exit reference so
                        // that it can be replace by a
                        // subroutine pointer created by DOES>
@@ -877,8 +944,8 @@ const PROGMEM char do_str[] = "do";
 // Run-Time: ( n1|u1 n2|u2 -- ) (R: -- loop-sys )
 void _do(void) {
   push(DO_SYS);
-  *pHere++ = DO_SYS_IDX;
   push((size_t)pHere); // store the origin address of the do loop
+  *pHere++ = DO_SYS_IDX;
 }
 
 const PROGMEM char does_str[] = "does>";
@@ -888,7 +955,8 @@ const PROGMEM char does_str[] = "does>";
 void _does(void) {
   *pHere++ = SUBROUTINE_IDX;
   // Store location for a subroutine call
-  *pHere++ = (size_t)pHere + sizeof(cell_t);
+  *pHere = (size_t)(pHere + 2);
+  pHere++;
   *pHere++ = EXIT_IDX;
   // Start Subroutine coding
 }
@@ -897,14 +965,14 @@ const PROGMEM char drop_str[] = "drop";
 // ( x -- )
 // Remove x from stack
 void _drop(void) {
-  pop();
+  tos--;
 }
 
 const PROGMEM char dupe_str[] = "dup";
 // ( x -- x x )
 // Duplicate x
 void _dupe(void) {
-  push(stack[tos]);
+  PUSH(TOP);
 }
 
 const PROGMEM char else_str[] = "else";
@@ -1028,16 +1096,18 @@ const PROGMEM char execute_str[] = "execute";
 // Remove xt from the stack and preform the semantics identified by it. Other
 // stack effects are due to the word EXECUTEd
 void _execute(void) {
-  func function;
   w = pop();
   if (w > 255) {
     // rpush(0);
-    rPush((cell_t) ip);        // CAL - Push our return address
+    rPush((size_t) ip);        // CAL - Push our return address
     ip = (cell_t *)w;          // set the ip to the XT (memory location)
     executeWord();
   } else {
-    function = (func) pgm_read_word(&flashDict[w - 1].function);
-    function();
+#ifdef EN_PROFILE
+    if (profiling) profilePrimitive(w);
+    else
+#endif
+    executePrimitive(w);
     if (errorCode) return;
   }
 }
@@ -1074,11 +1144,11 @@ const PROGMEM char find_str[] = "find";
 void _find(void) {
   uint8_t index = 0;
 
-  cell_t *addr = (cell_t *)pop();
+  uint8_t *addr = (uint8_t *)pop();
   cell_t length = *addr++;
 
   char *ptr = (char*) addr;
-  if (length = 0) {
+  if (length == 0) {
     push(-16);
     _throw();
     return;
@@ -1088,29 +1158,24 @@ void _find(void) {
     return;
   }
 
-  pUserEntry = pLastUserEntry;
+  uint8_t hash = hashName(ptr, length);
   // First search through the user dictionary
-  while (pUserEntry) {
-    if (strcmp(pUserEntry->name, ptr) == 0) {
-      length = strlen(pUserEntry->name);
-      push((size_t)pUserEntry->cfa);
-      wordFlags = pUserEntry->flags;
-      if (wordFlags & IMMEDIATE) push(1);
-      else push(-1);
-      return;
-    }
-    pUserEntry = (userEntry_t*)pUserEntry->prevEntry;
+  pUserEntry = findUserEntry(ptr, length, hash);
+  if (pUserEntry) {
+    push((size_t)entryCfa(pUserEntry));
+    wordFlags = pUserEntry->flags;
+    if (wordFlags & IMMEDIATE) push(1);
+    else push(-1);
+    return;
   }
   // Second Search through the flash Dictionary
-  while (pgm_read_word(&flashDict[index].name)) {
-    if (!strcasecmp_P(ptr, (char*)pgm_read_word(&flashDict[index].name))) {
-      push(index + 1);
-      wordFlags = pgm_read_byte(&(flashDict[index].flags)); 
-      if (wordFlags & IMMEDIATE) push(1);
-      else push(-1);
-      return;
-    }
-    index++;
+  index = findFlashEntry(ptr, length, hash);
+  if (index) {
+    push(index);
+    wordFlags = pgm_read_byte(&(flashDict[index - 1].flags)); 
+    if (wordFlags & IMMEDIATE) push(1);
+    else push(-1);
+    return;
   }
   push((size_t)ptr);
   push(0);
@@ -1146,14 +1211,14 @@ const PROGMEM char i_str[] = "i";
 // Interpretation: undefined
 // Execution: ( -- n|u ) (R: loop-sys -- loop-sys )
 void _i(void) {
-  push(rStack[rtos - 1]);
+  PUSH(loopIndex + loopLimit);
 }
 
 const PROGMEM char if_str[] = "if";
 // Compilation: (C: -- orig )
 // Run-Time: ( x -- )
 void _if(void) {
-  *pHere++ = ZJUMP_IDX;
+  compileWord(ZJUMP_IDX);
   *pHere = 0;
   push((size_t)pHere++);
 }
@@ -1162,8 +1227,8 @@ const PROGMEM char immediate_str[] = "immediate";
 // ( -- )
 // make the most recent definition an immediate word.
 void _immediate(void) {
-  if (pLastUserEntry) {
-    pLastUserEntry->flags |= IMMEDIATE;
+  if (pLatest) {
+    pLatest->flags |= IMMEDIATE;
   }
 }
 
@@ -1171,7 +1236,7 @@ const PROGMEM char invert_str[] = "invert";
 // ( x1 -- x2 )
 // invert all bits in x1, giving its logical inverse x2
 void _invert(void)   {
-  push(~pop());
+  TOP = ~TOP;
 }
 
 const PROGMEM char j_str[] = "j";
@@ -1181,7 +1246,7 @@ const PROGMEM char j_str[] = "j";
 // if the loop control parameters of the next-outer loop, loop-sys1, are
 // unavailable.
 void _j(void) {
-  push(rStack[rtos - 4]);
+  PUSH(rStack[rtos - 1] + rStack[rtos]);   // The frame saved by the inner DO
 }
 
 const PROGMEM char key_str[] = "key";
@@ -1205,7 +1270,7 @@ const PROGMEM char literal_str[] = "literal";
 // Place x on the stack
 void _literal(void) {
   if (state) {
-    *pHere++ = LITERAL_IDX;
+    compileWord(LITERAL_IDX);
     *pHere++ = pop();
   } else {
     push(*ip++);
@@ -1217,58 +1282,42 @@ const PROGMEM char loop_str[] = "loop";
 // Compilation: (C: do-sys -- )
 // Run-Time: ( -- ) (R: loop-sys1 -- loop-sys2 )
 void _loop(void) {
-  *pHere++ = LOOP_SYS_IDX;
-  cell_t start_addr = pop();
-  *pHere++ = start_addr;
-  cell_t stop_addr = (cell_t)pHere;
-  cell_t* ptr = start_addr;
-  do {
-    if (*ptr++ == LEAVE_SYS_IDX) {
-      if (*ptr == 0) {
-        *ptr = stop_addr;
-      }
-    }
-  } while (ptr != stop_addr);
-  if ( pop() != DO_SYS) {
-    push(-22);
-    _throw();
-  }
+  closeLoop(LOOP_SYS_IDX, DO_SYS);
 }
 
 const PROGMEM char lshift_str[] = "lshift";
 // ( x1 u -- x2 )
 // x2 is x1 shifted to left by u positions.
 void _lshift(void) {
-  cell_t u = pop();
-  cell_t x1 = pop();
-  push(x1 << u);
+  NOS <<= TOP;
+  tos--;
 }
 
 const PROGMEM char m_star_str[] = "m*";
 // ( n1 n2 -- d )
 // d is the signed product of n1 times n2.
 void _m_star(void) {
-  push(pop() * pop());
+  cell_t n2 = pop();
+  cell_t n1 = pop();
+  dcell_t d = (dcell_t)n1 * (dcell_t)n2;
+  push((cell_t)d);
+  push((cell_t)(d >> sizeof(cell_t) * 8));
 }
 
 const PROGMEM char max_str[] = "max";
 // ( n1 n2 -- n3 )
 // n3 is the greater of of n1 or n2.
 void _max(void) {
-  cell_t n2 = pop();
-  cell_t n1 = pop();
-  if (n1 > n2) push(n1);
-  else push(n2);
+  if (TOP > NOS) NOS = TOP;
+  tos--;
 }
 
 const PROGMEM char min_str[] = "min";
 // ( n1 n2 -- n3 )
 // n3 is the lesser of of n1 or n2.
 void _min(void) {
-  cell_t n2 = pop();
-  cell_t n1 = pop();
-  if (n1 > n2) push(n2);
-  else push(n1);
+  if (TOP < NOS) NOS = TOP;
+  tos--;
 }
 
 const PROGMEM char mod_str[] = "mod";
@@ -1297,20 +1346,21 @@ const PROGMEM char negate_str[] = "negate";
 // Negate n1, giving its arithmetic inverse n2.
 // tested and fixed by Alex Moskovskij
 void _negate(void) {
-  push(-pop());
+  TOP = -TOP;
 }
 
 const PROGMEM char or_str[] = "or";
 // ( x1 x2 -- x3 )
 // x3 is the bit by bit logical or of x1 with x2
 void _or(void) {
-  push(pop() |  pop());
+  NOS |= TOP;
+  tos--;
 }
 
 const PROGMEM char over_str[] = "over";
 // ( x y -- x y x )
 void _over(void) {
-  push(stack[tos - 1]);
+  PUSH(NOS);
 }
 
 const PROGMEM char postpone_str[] = "postpone";
@@ -1319,20 +1369,18 @@ const PROGMEM char postpone_str[] = "postpone";
 // Append the compilation semantics of name to the current definition. An
 // ambiguous condition exists if name is not found.
 void _postpone(void) {
-  func function;
   if (!getToken()) {
     push(-16);
     _throw();
   }
-  if (isWord(cTokenBuffer)) {
+  if (isWord(cpToken, tokenLength)) {
     if (wordFlags & COMP_ONLY) {
       if (w > 255) {
         rPush(0);            // Push 0 as our return address
         ip = (cell_t *)w;          // set the ip to the XT (memory location)
         executeWord();
       } else {
-        function = (func) pgm_read_word(&flashDict[w - 1].function);
-        function();
+        executePrimitive(w);
         if (errorCode) return;
       }
     } else {
@@ -1368,7 +1416,12 @@ const PROGMEM char r_fetch_str[] = "r@";
 // Execution: ( -- x ) (R: x -- x)
 // Copy x from the return stack to the data stack.
 void _r_fetch(void) {
-  push(rStack[rtos]);
+  if (rtos < 0) {
+    push(-6);
+    _throw();
+    return;
+  }
+  PUSH(rStack[rtos]);
 }
 
 const PROGMEM char recurse_str[] = "recurse";
@@ -1387,10 +1440,10 @@ const PROGMEM char repeat_str[] = "repeat";
 // Run-Time ( -- )
 // Continue execution at the location given.
 void _repeat(void) {
-  cell_t dest;
   cell_t* orig;
   *pHere++ = JUMP_IDX;
-  *pHere++ = pop() - (size_t)pHere;
+  *pHere = pop() - (size_t)pHere;
+  pHere++;
   orig = (cell_t*)pop();
   *orig = (size_t)pHere - (size_t)orig;
 }
@@ -1398,12 +1451,10 @@ void _repeat(void) {
 const PROGMEM char rot_str[] = "rot";
 // ( x1 x2 x3 -- x2 x3 x1)
 void _rot(void) {
-  cell_t x3 = pop();
-  cell_t x2 = pop();
-  cell_t x1 = pop();
-  push(x2);
-  push(x3);
-  push(x1);
+  cell_t x1 = stack[tos - 2];
+  stack[tos - 2] = NOS;
+  NOS = TOP;
+  TOP = x1;
 }
 
 const PROGMEM char rshift_str[] = "rshift";
@@ -1411,9 +1462,8 @@ const PROGMEM char rshift_str[] = "rshift";
 // x2 is x1 shifted to right by u positions.
 // tested and fixed by Alex Moskovskij
 void _rshift(void) {
-  ucell_t u = pop();
-  ucell_t x1 = pop();
-  push(x1 >> u);
+  NOS = (ucell_t)NOS >> TOP;
+  tos--;
 }
 
 const PROGMEM char s_quote_str[] = "s\x22"; 
@@ -1425,8 +1475,7 @@ const PROGMEM char s_quote_str[] = "s\x22";
 // Return c-addr and u describing a string consisting of the characters ccc. A program
 // shall not alter the returned string.
 void _s_quote(void) {
-  uint8_t i;
-  char length;
+  uint8_t length;
   if (flags & EXECUTE) {
     push((size_t)ip);
     cell_t len = strlen((char*)ip);
@@ -1436,15 +1485,15 @@ void _s_quote(void) {
   }
   else if (state) {
     cDelimiter = '"';
-    if (!getToken()) {
+    if (!parseToken()) {
       push(-16);
       _throw();
     }
-    length = strlen(cTokenBuffer);
+    length = tokenLength;
     *pHere++ = S_QUOTE_IDX;
     char *ptr = (char*)pHere;
     for (uint8_t i = 0; i < length; i++) {
-      *ptr++ = cTokenBuffer[i];
+      *ptr++ = cpToken[i];
     }
     *ptr++ = '\0';    // Terminate String
     pHere = (cell_t *)ptr;
@@ -1517,12 +1566,9 @@ void _state(void) {
 
 const PROGMEM char swap_str[] = "swap";
 void _swap(void) { // x y -- y x
-  cell_t x, y;
-
-  y = pop();
-  x = pop();
-  push(y);
-  push(x);
+  cell_t x = TOP;
+  TOP = NOS;
+  NOS = x;
 }
 
 const PROGMEM char then_str[] = "then";
@@ -1557,8 +1603,8 @@ const PROGMEM char u_lt_str[] = "u<";
 // ( u1 u2 -- flag )
 // flag is true if and only if u1 is less than u2.
 void _u_lt(void) {
-  if ((ucell_t)pop() > ucell_t(pop())) push(TRUE);
-  else push(FALSE);
+  NOS = ((ucell_t)NOS < (ucell_t)TOP) ? TRUE : FALSE;
+  tos--;
 }
 
 const PROGMEM char um_star_str[] = "um*";
@@ -1580,9 +1626,9 @@ const PROGMEM char um_slash_mod_str[] = "um/mod";
 // Divide ud by u1 giving quotient u3 and remainder u2.
 void _um_slash_mod(void) {
   ucell_t u1 = pop();
-  udcell_t lsb = pop();
-  udcell_t msb = pop();
-  udcell_t ud = (msb << 16) + (lsb);
+  udcell_t msb = (ucell_t)pop();
+  udcell_t lsb = (ucell_t)pop();
+  udcell_t ud = (msb << sizeof(ucell_t) * 8) + (lsb);
   push(ud % u1);
   push(ud / u1);
 }
@@ -1591,13 +1637,7 @@ const PROGMEM char unloop_str[] = "unloop";
 // Interpretation: Undefine
 // Execution: ( -- )(R: loop-sys -- )
 void _unloop(void) {
-  serial_print_P(not_done_str); 
-  rPop();
-  rPop();
-  if (rPop() != LOOP_SYS) {
-    push(-22);
-    _throw();
-  }
+  exitLoop();
 }
 
 const PROGMEM char until_str[] = "until";
@@ -1605,7 +1645,7 @@ const PROGMEM char until_str[] = "until";
 // Compilation: (C: dest -- )
 // Run-Time: ( x -- )
 void _until(void) {
-  *pHere++ = ZJUMP_IDX;
+  compileWord(ZJUMP_IDX);
   *pHere = pop() - (size_t)pHere;
   pHere += 1;
 }
@@ -1637,7 +1677,7 @@ void _while(void) {
   ucell_t dest;
   ucell_t orig;
   dest = pop();
-  *pHere++ = ZJUMP_IDX;
+  compileWord(ZJUMP_IDX);
   orig = (size_t)pHere;
   *pHere++ = 0;
   push(orig);
@@ -1663,13 +1703,13 @@ void _word(void) {
   uint8_t *start, *ptr;
 
   cDelimiter = (char)pop();
-  start = (uint8_t *)pHere++;
-  ptr = (uint8_t *)pHere;
+  start = (uint8_t *)pHere;           // transient memory at HERE
+  ptr = start + 1;
   while (cpToIn <= cpSourceEnd) {
     if (*cpToIn == cDelimiter || *cpToIn == 0) {
-      *((cell_t *)start) = (ptr - start) - sizeof(cell_t); // write the length byte
-      pHere = (cell_t *)start;                     // reset pHere (transient memory)
-      push((size_t)start);                // push the c-addr onto the stack
+      *start = (ptr - start) - 1;     // write the length byte
+      *ptr = '\0';                    // terminated for FIND
+      push((size_t)start);            // push the c-addr onto the stack
       cpToIn++;
       break;
     } else *ptr++ = *cpToIn++;
@@ -1681,7 +1721,8 @@ const PROGMEM char xor_str[] = "xor";
 // ( x1 x2 -- x3 )
 // x3 is the bit by bit exclusive or of x1 with x2
 void _xor(void) {
-  push(pop() ^  pop());
+  NOS ^= TOP;
+  tos--;
 }
 
 const PROGMEM char left_bracket_str[] = "[";
@@ -1708,7 +1749,7 @@ void _bracket_tick(void) {
     push(-16);
     _throw();
   }
-  if (isWord(cTokenBuffer)) {
+  if (isWord(cpToken, tokenLength)) {
     *pHere++ = LITERAL_IDX;
     *pHere++ = w;
   } else {
@@ -1761,18 +1802,14 @@ const PROGMEM char zero_not_equal_str[] = "0<>";
 // ( x -- flag)
 // flag is true if and only if x is not equal to zero. 
 void _zero_not_equal(void) { 
-  w = pop();
-  if (w == 0) push(FALSE);
-  else push(TRUE);
+  TOP = TOP ? TRUE : FALSE;
 }
 
 const PROGMEM char zero_greater_str[] = "0>";
 // (n -- flag)
 // flag is true if and only if n is greater than zero.
 void _zero_greater(void) {
-  w = pop();
-  if (w > 0) push(TRUE);
-  else push(FALSE);
+  TOP = (TOP > 0) ? TRUE : FALSE;
 }
 
 const PROGMEM char two_to_r_str[] = "2>r";
@@ -1839,10 +1876,8 @@ const PROGMEM char neq_str[] = "<>";
 // (x1 x2 -- flag)
 // flag is true if and only if x1 is not bit-for-bit the same as x2.
 void _neq(void) {
-  cell_t x2 = pop();
-  cell_t x1 = pop();
-  if (x1 != x2) push(TRUE);
-  else push(FALSE); 
+  NOS = (NOS != TOP) ? TRUE : FALSE;
+  tos--;
 }
 
 const PROGMEM char hex_str[] = "hex";
@@ -1881,9 +1916,7 @@ static void _of(void) {
   rPush(pop());         // Move to return stack
 
   push(OF_SYS);
-  *pHere++ = OVER_IDX;  // Postpone over
-  *pHere++ = EQUAL_IDX; // Postpone =
-  *pHere++ = ZJUMP_IDX; // If
+  compileWord(OVER_EQ_ZJUMP_IDX); // Postpone over = if
   *pHere = 0;           // Filled in by endof
   push((size_t) pHere++);// Push address of jump address onto control stack
   push(rPop());         // Bring of count back
@@ -1918,7 +1951,7 @@ static void _endof(void) {
     return;
   }
   // Place forward jump address onto control stack
-  push((cell_t) forward);
+  push((size_t) forward);
   push(rPop());          // Bring of count back
 }
 
@@ -1948,6 +1981,250 @@ static void _endcase(void) {
   }
 }
 
+const PROGMEM char marker_str[] = "marker";
+// ( "<spaces>name" -- )
+// Skip leading space delimiters. Parse name delimited by a space. Create a
+// definition for name with the execution semantics defined below.
+// name Execution: ( -- )
+// Restore all dictionary allocation and search order pointers to the state
+// they had just prior to the definition of name. Remove the definition of
+// name and all subsequent definitions.
+void _marker(void) {
+  openEntry();
+  if (errorCode) return;
+  *pHere++ = LITERAL_IDX;
+  *pHere++ = (size_t)pCodeStart;   // Its own XT
+  *pHere++ = FORGET_SYS_IDX;
+  closeEntry();
+}
+
+const PROGMEM char question_do_str[] = "?do";
+// Compilation: (C: -- do-sys)
+// Run-Time: ( n1|u1 n2|u2 -- ) (R: -- | loop-sys )
+// If n1|u1 is equal to n2|u2, continue execution at the location given by the
+// consumer of do-sys. Otherwise set up loop control parameters with index
+// n2|u2 and limit n1|u1 and continue executing immediately following ?DO.
+void _question_do(void) {
+  push(DO_SYS);
+  push((size_t)pHere);
+  *pHere++ = QDO_SYS_IDX;
+  *pHere++ = 0;        // Resolved by LOOP or +LOOP
+}
+
+#endif
+
+/*******************************************************************************/
+/**                               Block Set                                   **/
+/**  Blocks live in EEPROM, see blockBuffer_t. Block 1 starts at address 0,   **/
+/**  where eeLoad stores its source, and save-image fills the last blocks, so **/
+/**  use the blocks in between. Buffers are written back only by              **/
+/**  SAVE-BUFFERS, FLUSH and when they are reused, and then through           **/
+/**  eeUpdate() so the bytes that did not change are not written again.       **/
+/*******************************************************************************/
+#ifdef BLOCK_SET
+/*******************************************************************************/
+/** Writes a buffer back if it was UPDATEd. Returns false if EEPROM did not    **/
+/** take it.                                                                  **/
+/*******************************************************************************/
+bool saveBlock(blockBuffer_t* b) {
+  if (b->dirty) {
+    uint16_t addr = (b->blk - 1) * BLOCK_SIZE;
+    for (uint16_t i = 0; i < BLOCK_SIZE; i++) {
+      if (!eeUpdate(addr + i, b->data[i])) return false;
+    }
+    b->dirty = false;
+  }
+  return true;
+}
+
+/*******************************************************************************/
+/** Writes every UPDATEd buffer back in order of block number.                **/
+/*******************************************************************************/
+bool saveBuffers(void) {
+  cell_t last = 0;
+  blockBuffer_t* next;
+  do {
+    next = NULL;
+    for (blockBuffer_t* b = blockBuffers; b < blockBuffers + BLOCK_BUFFERS; b++) {
+      if (b->dirty && b->blk > last && (!next || b->blk < next->blk)) next = b;
+    }
+    if (next) {
+      if (!saveBlock(next)) return false;
+      last = next->blk;
+    }
+  } while (next);
+  return true;
+}
+
+/*******************************************************************************/
+/** Returns the buffer holding block u and makes it the current one. If no    **/
+/** buffer holds it, the free or least recently used buffer is written back   **/
+/** and assigned to u, and read from EEPROM if read is true. Throws and       **/
+/** returns NULL if u is not a block or the old block could not be written.   **/
+/*******************************************************************************/
+blockBuffer_t* assignBlock(cell_t u, bool read) {
+  blockBuffer_t* b;
+  blockBuffer_t* victim = NULL;
+
+  if (u < 1 || u > BLOCK_COUNT) {
+    push(-35);
+    _throw();
+    return NULL;
+  }
+  for (b = blockBuffers; b < blockBuffers + BLOCK_BUFFERS; b++) {
+    if (b->blk == u) break;
+    if (!victim || (victim->blk && (!b->blk ||
+        (uint16_t)(blockClock - b->used) > (uint16_t)(blockClock - victim->used)))) {
+      victim = b;
+    }
+  }
+  if (b == blockBuffers + BLOCK_BUFFERS) {
+    b = victim;
+    if (!saveBlock(b)) {
+      push(-34);
+      _throw();
+      return NULL;
+    }
+    b->blk = u;
+    if (read) {
+      uint16_t addr = (u - 1) * BLOCK_SIZE;
+      for (uint16_t i = 0; i < BLOCK_SIZE; i++) b->data[i] = EEPROM.read(addr + i);
+    }
+  }
+  b->used = ++blockClock;
+  pBlock = b;
+  return b;
+}
+
+const PROGMEM char blk_str[] = "blk";
+// ( -- a-addr )
+// a-addr is the address of a cell containing zero or the number of the block
+// being interpreted.
+void _blk(void) {
+  push((size_t)&blk);
+}
+
+const PROGMEM char block_str[] = "block";
+// ( u -- a-addr )
+// a-addr is the address of the first character of the block buffer assigned to
+// block u. If u is not in a buffer, the least recently used buffer is written
+// back if it was UPDATEd and then filled with the contents of block u.
+void _block(void) {
+  blockBuffer_t* b = assignBlock(pop(), true);
+  if (b) push((size_t)b->data);
+}
+
+const PROGMEM char buffer_str[] = "buffer";
+// ( u -- a-addr )
+// As BLOCK, except that the buffer is not read from EEPROM if u was not
+// already in one.
+void _buffer(void) {
+  blockBuffer_t* b = assignBlock(pop(), false);
+  if (b) push((size_t)b->data);
+}
+
+const PROGMEM char empty_buffers_str[] = "empty-buffers";
+// ( -- )
+// Unassign all block buffers without writing back the UPDATEd ones.
+void _empty_buffers(void) {
+  for (uint8_t i = 0; i < BLOCK_BUFFERS; i++) {
+    blockBuffers[i].blk = 0;
+    blockBuffers[i].dirty = false;
+  }
+  pBlock = NULL;
+}
+
+const PROGMEM char flush_str[] = "flush";
+// ( -- )
+// Perform the function of SAVE-BUFFERS, then unassign all block buffers.
+void _flush(void) {
+  if (!saveBuffers()) {
+    push(-34);
+    _throw();
+    return;
+  }
+  _empty_buffers();
+}
+
+const PROGMEM char list_str[] = "list";
+// ( u -- )
+// Display block u in lines of BLOCK_LINE characters and store u in SCR.
+void _list(void) {
+  cell_t u = pop();
+  blockBuffer_t* b = assignBlock(u, true);
+  if (!b) return;
+  scr = u;
+  for (uint8_t line = 0; line < BLOCK_SIZE / BLOCK_LINE; line++) {
+    if (line < 10) Serial.print(' ');
+    Serial.print((int)line);
+    Serial.print(' ');
+    for (uint8_t i = 0; i < BLOCK_LINE; i++) {
+      char c = b->data[line * BLOCK_LINE + i];
+      Serial.write(c >= ' ' && c <= MAX_CHAR ? c : ' ');  // Erased is 0xFF
+    }
+    Serial.println();
+  }
+}
+
+const PROGMEM char load_str[] = "load";
+// ( i*x u -- j*x )
+// Save the current input source specification. Store u in BLK and interpret
+// block u, up to the first erased (0xFF) or null character, as one input
+// source. When done, restore the prior input source specification. The text
+// is copied out of the buffer, so the words LOADed may use BLOCK freely.
+void _load(void) {
+  char* tempSource = cpSource;
+  char* tempSourceEnd = cpSourceEnd;
+  char* tempToIn = cpToIn;
+  cell_t tempBlk = blk;
+  cell_t u = pop();
+  char text[BLOCK_SIZE + 1];      // With room for a terminating null
+  uint16_t length;
+
+  blockBuffer_t* b = assignBlock(u, true);
+  if (!b) return;
+  for (length = 0; length < BLOCK_SIZE; length++) {
+    char c = b->data[length];
+    if (c == 0 || (uint8_t)c == 0xFF) break;
+    text[length] = c;
+  }
+  text[length] = '\0';
+  blk = u;
+  cpSource = text;
+  cpSourceEnd = cpSource + length;
+  cpToIn = cpSource;
+  interpreter();
+  blk = tempBlk;
+  cpSource = tempSource;
+  cpSourceEnd = tempSourceEnd;
+  cpToIn = tempToIn;
+}
+
+const PROGMEM char save_buffers_str[] = "save-buffers";
+// ( -- )
+// Write the UPDATEd block buffers back to EEPROM and mark them unmodified.
+// Only the bytes that changed are written.
+void _save_buffers(void) {
+  if (!saveBuffers()) {
+    push(-34);
+    _throw();
+  }
+}
+
+const PROGMEM char scr_str[] = "scr";
+// ( -- a-addr )
+// a-addr is the address of a cell containing the block number last LISTed.
+void _scr(void) {
+  push((size_t)&scr);
+}
+
+const PROGMEM char update_str[] = "update";
+// ( -- )
+// Mark the current block buffer, the one given by the last BLOCK or BUFFER, as
+// modified so it is written back before it is reused.
+void _update(void) {
+  if (pBlock) pBlock->dirty = true;
+}
 #endif
 
 /*******************************************************************************/
@@ -1970,14 +2247,14 @@ void _throw(void) {
   uint8_t index = 0;
   int tableCode;
   //_cr();
-  Serial.print(cTokenBuffer);
+  for (uint8_t i = 0; i < tokenLength; i++) Serial.print(cpToken[i]);
   Serial.print(F(" EXCEPTION("));
   do {
-    tableCode = pgm_read_word(&(exception[index].code));
+    tableCode = (int16_t)pgm_read_word(&(exception[index].code));
     if (errorCode == tableCode) {
       Serial.print((int)errorCode);
       Serial.print(F("): "));
-      serial_print_P((char*) pgm_read_word(&exception[index].name));
+      serial_print_P((char*) pgm_read_ptr(&exception[index].name));
       _cr();
     }
     index++;
@@ -1998,7 +2275,7 @@ void _throw(void) {
 const PROGMEM char key_question_str[] = "key?";
 void _key_question(void) {
     
-    if( Serial.available() > 0) {
+    if( serialAvailable()) {
         push(TRUE);
     } else {
         push(FALSE);
@@ -2024,8 +2301,8 @@ void _key_question(void) {
 #ifdef TOOLS_SET
 const PROGMEM char dot_s_str[] = ".s";
 void _dot_s(void) {
-  char i;
-  char depth = tos + 1;
+  int8_t i;
+  int8_t depth = tos + 1;
   if (tos >= 0) {
     for (i = 0; i < depth ; i++) {
       w = stack[i];
@@ -2073,6 +2350,24 @@ void _dump(void) {
   }
 }
 
+const PROGMEM char forget_str[] = "forget";
+// ( "<spaces>name" -- )
+// Skip leading space delimiters. Parse name delimited by a space. Find name,
+// then delete name from the dictionary along with all words added to the
+// dictionary after name. An ambiguous condition exists if name cannot be found.
+void _forget(void) {
+  if (getToken()) {
+    userEntry_t* e = findUserEntry(cpToken, tokenLength,
+                                   hashName(cpToken, tokenLength));
+    if (e) {
+      forgetEntry(e);
+      return;
+    }
+  }
+  push(-13);
+  _throw();
+}
+
 const PROGMEM char see_str[] = "see";
 // ("<spaces>name" -- )
 // Display a human-readable representation of the named word's definition. The
@@ -2104,11 +2399,33 @@ void _see(void) {
       xtToName(*addr);
       switch (*addr) {
         case 2:
+        case LIT_PLUS_IDX:
           isLiteral = true;
+          // fall through
         case 4:
         case 5:
+        case DUP_ZJUMP_IDX:
+        case OVER_EQ_ZJUMP_IDX:
+          Serial.print(F("("));
+          Serial.print(*++addr);
+          Serial.print(F(")"));
+          break;
+        case LOOP_SYS_IDX:
+        case LEAVE_SYS_IDX:
+        case PLUS_LOOP_SYS_IDX:
+        case QDO_SYS_IDX:
+        case FOR_SYS_IDX:
+        case NEXT_SYS_IDX:
+          Serial.print(F("($"));
+          Serial.print(*++addr, HEX);
+          Serial.print(F(")"));
+          break;
+        case LIT_EQ_ZJUMP_IDX:
+        case LIT_OF_IDX:
           Serial.print(F("("));
           Serial.print(*++addr);
+          Serial.print(F(")("));
+          Serial.print(*++addr);
           Serial.print(F(")"));
           break;
         case 13:
@@ -2134,22 +2451,21 @@ const PROGMEM char words_str[] = "words";
 void _words(void) { // --
   uint8_t count = 0;
   uint8_t index = 0;
-  uint8_t length = 0;
-  char* pChar;
 
-  while (pgm_read_word(&flashDict[index].name)) {
+  while (pgm_read_ptr(&flashDict[index].name)) {
     if (count > 70) {
       Serial.println();
       count = 0;
     }
     if (!(pgm_read_byte(&(flashDict[index].flags)) & SMUDGE)) {
-      count += serial_print_P((char*)pgm_read_word(&flashDict[index].name));
+      count += serial_print_P((char*)pgm_read_ptr(&flashDict[index].name));
       count += serial_print_P(sp_str);
     }
     index++;
   }
 
-  pUserEntry = pLastUserEntry;
+  // The public entries, then any private headers not yet sealed
+  pUserEntry = pLastUserEntry ? pLastUserEntry : pLastPrivate;
   while (pUserEntry) {
     if (count > 70) {
       Serial.println();
@@ -2159,7 +2475,9 @@ void _words(void) { // --
       count += Serial.print(pUserEntry->name);
       count += serial_print_P(sp_str);
     }
-    pUserEntry = (userEntry_t*)pUserEntry->prevEntry;
+    if (prevEntry(pUserEntry)) pUserEntry = prevEntry(pUserEntry);
+    else if (pUserEntry->flags & PRIVATE) pUserEntry = NULL;
+    else pUserEntry = pLastPrivate;
   }
   Serial.println();
 }
@@ -2189,11 +2507,11 @@ void _eeprom_read(void) {             // address -- value
 
 const PROGMEM char eeWrite_str[] = "eeWrite";
 void _eeprom_write(void) {             // value address --
-  char address;
-  char value;
-  address = (char) pop();
-  value = (char) pop();
-  EEPROM.write(address, value);
+  uint16_t address;
+  uint8_t value;
+  address = pop();
+  value = pop();
+  eeUpdate(address, value);
 }
 
 // >>> Contributed by Andrew Holt
@@ -2217,7 +2535,6 @@ uint8_t eeGetLine(char *addr, int16_t *eeAddr) {
 
     uint8_t len=0;
     uint8_t inChar;
-    char *start = addr;
     bool exitFlag = false;
     uint16_t length = BUFFER_SIZE;
 
@@ -2253,9 +2570,7 @@ uint8_t eeGetLine(char *addr, int16_t *eeAddr) {
  */
 const PROGMEM char eeInterpret_str[] = "eeInterpret";
 void _eeInterpret(void) {
-    uint8_t dataByte;
     int16_t eeIdx=0;
-    uint8_t buffIdx = 0;
     bool exitFlag=false;
     uint8_t len=0;
 
@@ -2265,40 +2580,17 @@ void _eeInterpret(void) {
     memset( cpSource,' ', BUFFER_SIZE );
 
     while( exitFlag == false) {
-        Serial.print("eeIdx : ");
-        Serial.println( eeIdx );
-
         len = eeGetLine(cpSource, &eeIdx);
 
         if( len < 255) {
-
-            Serial.print("Len   : ");
-            Serial.println( len );
-
             cpSourceEnd = cpSource + len;
 
-            Serial.println( cpSource );
-
             if (cpSourceEnd > cpSource) {
-
-                Serial.print("State(before):");
-                Serial.println( state );
-
                 interpreter();
 
-                Serial.print("State(before):");
-                Serial.println( state );
-
-                Serial.print("errorCode:");
-                Serial.println(errorCode);
-
                 if( errorCode) {
                     errorCode = 0;
                     exitFlag = true;
-                } else {
-                    if(!state) {
-                        char i = tos + 1;
-                    }
                 }
             }
         } else {
@@ -2352,27 +2644,20 @@ void _eeInterpret(void) {
  */
 const PROGMEM char eeload_str[] = "eeLoad";
 void _eeLoad(void) {
-    uint8_t incoming[132];
     uint8_t exitFlag=0;
     uint8_t inByte;
-    uint8_t data;
     uint8_t lastByte=0;
 
     uint16_t eepromIdx=0;
 
-    uint8_t seq;
-    uint8_t iseq;
-
-    uint8_t cksum;
-    long now;
-
-    Serial.setTimeout(10000);
-
     Serial.print(">> ");
     while (exitFlag == 0) {
-        while(!Serial.available()) {
+        // The ring buffer and flow control hold the text coming in while
+        // a byte is written, which takes about 3.3 ms.
+        while(!serialAvailable()) {
+            yield();
         }
-        inByte = Serial.read();
+        inByte = serialRead();
 
         if( lastByte == '\r' && inByte == '\n' ) { // Empty line.
             Serial.write('\r');
@@ -2384,12 +2669,8 @@ void _eeLoad(void) {
         } else {
             lastByte = inByte;
             Serial.write(inByte);
-            EEPROM.write( eepromIdx, inByte);
-
-            data = EEPROM.read( eepromIdx );
-            if ( data != inByte ) {
-                EEPROM.write( eepromIdx, inByte);
-                delay(10);
+            if( eepromIdx < EEPROM.length() ) {
+                eeUpdate( eepromIdx, inByte);
             }
 
             eepromIdx++;
@@ -2399,7 +2680,9 @@ void _eeLoad(void) {
             }
         }
     }
-
+    if( eepromIdx < EEPROM.length() ) {
+        eeUpdate( eepromIdx, 0xff);     // Mark the end of the source
+    }
 }
 
 /*
@@ -2419,7 +2702,6 @@ void _eeprom_clear(void) {             // value address --
     uint16_t len;
     uint16_t end;
     uint16_t idx;
-    uint8_t data;
 
     len=pop();
     start = pop();
@@ -2431,11 +2713,7 @@ void _eeprom_clear(void) {             // value address --
     }
 
     for( idx = start; idx < end; idx++) {
-        data = EEPROM.read( idx );
-        if( data != 0xff ) {
-            EEPROM.write(idx,0xff);
-            delay(10);
-        }
+        eeUpdate(idx, 0xff);
     }
 }
 
@@ -2502,8 +2780,6 @@ void _eeprom_dump(void) {             // address count --
     uint16_t addr;
     uint16_t cnt;
     uint16_t i;
-    uint8_t n;
-    char buf[17];
 
     cnt=(pop() + 0x0f) & 0xff0;
     
@@ -2521,8 +2797,246 @@ void _eeprom_dump(void) {             // address count --
     }
     Serial.println();
 }
+
+const PROGMEM char eeWear_str[] = "eeWear";
+// ( -- )
+// Print the bytes written to EEPROM and the bytes eeUpdate() skipped because
+// they already held the value since the last eeWear, then, with BLOCK_SET, the
+// bytes written to each block since reset.
+void _eeWear(void) {
+  Serial.print(F("Written "));
+  Serial.print(eeWrites);
+  Serial.print(F(" Skipped "));
+  Serial.println(eeSkips);
+#ifdef BLOCK_SET
+  for (uint8_t i = 0; i < BLOCK_COUNT; i++) {
+    Serial.print(i + 1);
+    Serial.print(F(":"));
+    Serial.print(eeWearMap[i]);
+    Serial.print(i % 8 == 7 ? F("\r\n") : F(" "));
+  }
+  if (BLOCK_COUNT % 8) Serial.println();
+#endif
+  eeWrites = 0;
+  eeSkips = 0;
+}
+
+/********************************************************************************/
+/** Dictionary Image                                                           **/
+/**                                                                            **/
+/** save-image stores the compiled user dictionary in EEPROM so that setup()   **/
+/** restores it with one block read instead of interpreting the source again. **/
+/** The image is forthSpace up to HERE followed by an imageHeader_t, and ends  **/
+/** at the top of EEPROM. Source stored by eeLoad grows up from address 0, so  **/
+/** both are kept and setup() falls back to the source if the image is not    **/
+/** valid. The XTs of primitives in the image are only valid for the           **/
+/** flashDict[] that saved it, which the header records with flashVersion().   **/
+/********************************************************************************/
+#define IMAGE_HEADER  (EEPROM.length() - sizeof(imageHeader_t))
+#define IMAGE_SUMMED  offsetof(imageHeader_t, checksum)
+
+/********************************************************************************/
+/** Fletcher-16 checksum of len bytes of EEPROM from addr.                     **/
+/********************************************************************************/
+uint16_t eeChecksum(uint16_t addr, uint16_t len) {
+  uint16_t sum1 = 0;
+  uint16_t sum2 = 0;
+  while (len--) {
+    sum1 = (sum1 + EEPROM.read(addr++)) % 255;
+    sum2 = (sum2 + sum1) % 255;
+  }
+  return (sum2 << 8) | sum1;
+}
+
+void eeReadBlock(uint16_t addr, void* dst, uint16_t len) {
+  uint8_t* p = (uint8_t*)dst;
+  while (len--) *p++ = EEPROM.read(addr++);
+}
+
+/********************************************************************************/
+/** Writes len bytes to EEPROM at addr with eeUpdate(). Returns false if a     **/
+/** byte does not read back.                                                   **/
+/********************************************************************************/
+bool eeWriteBlock(uint16_t addr, const void* src, uint16_t len) {
+  const uint8_t* p = (const uint8_t*)src;
+  for ( ; len--; addr++, p++) {
+    if (!eeUpdate(addr, *p)) return false;
+  }
+  return true;
+}
+
+/********************************************************************************/
+/** Loads the image in EEPROM into forthSpace, replacing the user dictionary.  **/
+/** Returns 0 or the exception: -38 if there is no image and -33 if it is      **/
+/** damaged, too large, from another flashDict[] or saved with forthSpace at   **/
+/** another address. Code and literals hold absolute addresses, and a literal  **/
+/** cannot be told from a number, so an image is never moved.                 **/
+/********************************************************************************/
+cell_t loadImage(void) {
+  imageHeader_t image;
+
+  eeReadBlock(IMAGE_HEADER, &image, sizeof(image));
+  if (image.magic != IMAGE_MAGIC) return -38;
+  if (image.version != flashVersion() ||
+      (size_t)image.size > FORTH_SIZE * sizeof(cell_t) ||
+      (size_t)image.size > IMAGE_HEADER ||
+      (image.last != IMAGE_NONE && image.last >= image.size) ||
+      image.checksum != eeChecksum(IMAGE_HEADER - image.size,
+                                   image.size + IMAGE_SUMMED) ||
+      image.origin != (size_t)forthSpace) {
+    return -33;
+  }
+  eeReadBlock(IMAGE_HEADER - image.size, forthSpace, image.size);
+  pHere = (cell_t*)((size_t)forthSpace + image.size);
+  pOldHere = pHere;
+  if (image.last == IMAGE_NONE) pLastUserEntry = NULL;
+  else pLastUserEntry = (userEntry_t*)((size_t)forthSpace + image.last);
+  base = image.base;
+  pTaskList = NULL;              // Tasks in the old dictionary are gone
+  pLastPrivate = NULL;           // and so are the private headers
+  pNames = (char*)&forthSpace[FORTH_SIZE];
+  pLatest = NULL;
+  linkUserBuckets();
+  return 0;
+}
+
+const PROGMEM char saveImage_str[] = "save-image";
+// ( -- )
+// Save the user dictionary, HERE and BASE to EEPROM as a dictionary image.
+// The image may not reach down into the source stored by eeLoad.
+void _save_image(void) {
+  imageHeader_t image;
+  size_t size = (size_t)pHere - (size_t)forthSpace;
+  size_t last = IMAGE_NONE;
+  uint16_t start;
+  uint16_t addr;
+
+  if (pLastUserEntry != NULL) last = (size_t)pLastUserEntry - (size_t)forthSpace;
+  // size and last must fit their uint16_t fields before they are narrowed
+  if (size > IMAGE_HEADER || size >= IMAGE_NONE ||
+      (pLastUserEntry != NULL && last >= size)) {
+    push(-34);
+    _throw();
+    return;
+  }
+  start = IMAGE_HEADER - size;
+  for (addr = 0; addr <= start && EEPROM.read(addr) != 0xFF; addr++);
+  if (addr > start) {            // The source ends above the image start
+    push(-34);
+    _throw();
+    return;
+  }
+  image.magic = IMAGE_MAGIC;
+  image.checksum = 0;
+  image.version = flashVersion();
+  image.size = size;
+  image.last = last;
+  image.base = base;
+  image.origin = (size_t)forthSpace;
+  if (eeWriteBlock(start, forthSpace, size) &&
+      eeWriteBlock(IMAGE_HEADER, &image, sizeof(image))) {
+    image.checksum = eeChecksum(start, size + IMAGE_SUMMED);
+    if (eeWriteBlock(IMAGE_HEADER + IMAGE_SUMMED, &image.checksum,
+                     sizeof(image.checksum))) return;
+  }
+  push(-34);
+  _throw();
+}
+
+const PROGMEM char loadImage_str[] = "load-image";
+// ( -- )
+// Replace the user dictionary, HERE and BASE with the image saved in EEPROM.
+void _load_image(void) {
+  cell_t error = loadImage();
+  if (error) {
+    push(error);
+    _throw();
+  }
+}
 #endif
 
+/********************************************************************************/
+/**                                 Tasks                                      **/
+/********************************************************************************/
+const PROGMEM char task_str[] = "task";
+// ( "<spaces>name" -- )
+// Create a definition for name and reserve a stopped task control block.
+// name Execution: ( -- task )
+void _task(void) {
+  openEntry();
+  *pHere++ = LITERAL_IDX;
+  *pHere = (size_t)(pHere + 2);   // After the EXIT below
+  pHere++;
+  closeEntry();
+  if (errorCode) return;
+  if (freeMem() < (sizeof(task_t) + sizeof(cell_t) - 1) / sizeof(cell_t)) {
+    push(-8);
+    _throw();
+    return;
+  }
+  task_t* t = (task_t*)pHere;
+  pHere += (sizeof(task_t) + sizeof(cell_t) - 1) / sizeof(cell_t);
+  memset(t, 0, sizeof(task_t));
+  t->tos = -1;
+  t->rtos = -1;
+}
+
+const PROGMEM char start_str[] = "start";
+// ( xt task -- )
+// Start task running the definition xt from the top, with empty stacks. It
+// gets its first turn at the next PAUSE of the operator and stops when xt
+// returns.
+void _start(void) {
+  task_t* t = (task_t*)pop();
+  cell_t xt = pop();
+  if (t == pTask) {             // Its task_t holds the operator's state
+    push(-21);
+    _throw();
+    return;
+  }
+  if (xt < 256) {
+    push(-12);
+    _throw();
+    return;
+  }
+  t->ip = (cell_t*)xt;
+  t->rStack[0] = 0;             // Return address that ends the task
+  t->rtos = 0;
+  t->tos = -1;
+  t->state = FALSE;
+  t->wake = millis();
+  t->status = TASK_RUNNING;
+  task_t* p = pTaskList;
+  while (p && p != t) p = (task_t*)p->next;
+  if (p == NULL) {
+    t->next = pTaskList;
+    pTaskList = t;
+  }
+}
+
+const PROGMEM char pause_str[] = "pause";
+// ( -- )
+// In a task, end its turn. In the operator, give every task that is awake
+// a turn.
+void _pause(void) {
+  serialPoll();                 // A task turn has no tokens to poll between
+  if (pTask) {
+    pTaskResume = ip;
+    ip = NULL;                  // Ends executeWord(), see runTask()
+  } else {
+    runTasks();
+  }
+}
+
+const PROGMEM char stop_str[] = "stop";
+// ( task -- )
+// Stop task. A task that stops itself ends its turn.
+void _stop(void) {
+  task_t* t = (task_t*)pop();
+  t->status = TASK_STOPPED;
+  if (t == pTask) _pause();
+}
+
 /********************************************************************************/
 /**                      Arduino Library Operations                            **/
 /********************************************************************************/
@@ -2533,8 +3047,32 @@ void _freeMem(void) {
 }
 
 const PROGMEM char delay_str[] = "delay";
+const PROGMEM char ms_str[] = "ms";
+// ( u -- )
+// Wait at least u milliseconds. A task sleeps and gives up its turn; the
+// operator lets the tasks run until the time is up.
 void _delay(void) {
-  delay(pop());
+  unsigned long wake = millis() + (ucell_t)pop();
+  if (pTask) {
+    pTask->wake = wake;
+    _pause();
+  } else {
+    while ((long)(millis() - wake) < 0) runTasks();
+  }
+}
+
+const PROGMEM char millis_str[] = "millis";
+// ( -- u )
+// u is the number of milliseconds since reset, modulo the cell size.
+void _millis(void) {
+  push(millis());
+}
+
+const PROGMEM char micros_str[] = "micros";
+// ( -- u )
+// u is the number of microseconds since reset, modulo the cell size.
+void _micros(void) {
+  push(micros());
 }
 
 const PROGMEM char pinWrite_str[] = "pinWrite";
@@ -2576,178 +3114,399 @@ void _toName(void) {
 }
 #endif
 
+/********************************************************************************/
+/**                           Compiler Operations                              **/
+/********************************************************************************/
+const PROGMEM char for_str[] = "for";
+// Compilation: (C: -- for-sys)
+// Run-Time: ( u -- ) (R: -- | loop-sys )
+// Run the loop up to NEXT u times, with I counting down from u-1 to zero.
+// If u is zero, continue execution following NEXT.
+void _for(void) {
+  push(FOR_SYS);
+  push((size_t)pHere);
+  *pHere++ = FOR_SYS_IDX;
+  *pHere++ = 0;        // Resolved by NEXT
+}
+
+const PROGMEM char next_str[] = "next";
+// Compilation: (C: for-sys -- )
+// Run-Time: ( -- ) (R: loop-sys1 -- | loop-sys2 )
+// Resolve the FOR and any LEAVE in the loop. At run-time, end the loop if the
+// index is zero, otherwise subtract one from it and run the loop again.
+void _next(void) {
+  closeLoop(NEXT_SYS_IDX, FOR_SYS);
+}
+
+const PROGMEM char inline_str[] = "inline";
+// ( -- )
+// Make the most recent definition inline. It is copied into every definition
+// that uses it, whatever its length, if compileInline() allows it.
+void _inline(void) {
+  if (pLatest) {
+    pLatest->flags |= INLINE;
+  }
+}
+
+const PROGMEM char private_str[] = "private";
+// ( -- )
+// Put the headers of the following definitions in the name region at the top
+// of Forth Space, where SEAL can drop them once the words that use them are
+// compiled. Their code stays in the dictionary.
+void _private(void) {
+  privateHeaders = true;
+}
+
+const PROGMEM char public_str[] = "public";
+// ( -- )
+// Put the headers of the following definitions in the dictionary again.
+void _public(void) {
+  privateHeaders = false;
+}
+
+const PROGMEM char seal_str[] = "seal";
+// ( -- )
+// Drop the private headers, giving their space back. The words they named can
+// no longer be found but still run from the definitions that compiled them.
+void _seal(void) {
+  if (pLatest && (pLatest->flags & PRIVATE)) pLatest = NULL;
+  pLastPrivate = NULL;
+  pNames = (char*)&forthSpace[FORTH_SIZE];
+}
+
+const PROGMEM char inline_limit_str[] = "inline-limit";
+// ( -- a-addr )
+// a-addr is the address of a cell holding the longest body, in cells, that is
+// inlined without INLINE. Store 0 in it to turn automatic inlining off.
+void _inline_limit(void) {
+  push((size_t)&inlineLimit);
+}
+
+#ifdef EN_BENCH_STATS
+const PROGMEM char dot_stats_str[] = ".stats";
+// ( -- )
+// Display the time since reset, the dispatch and token counts with their
+// rates, and the peak use of Forth Space and both stacks.
+void _dot_stats(void) {
+  float seconds = micros() / 1000000.0;
+  uint8_t depth;
+
+  if (pHere > pStatPeakHere) pStatPeakHere = pHere;
+  Serial.print(F("\r\n Elapsed: "));
+  Serial.print(micros() / 1000);
+  Serial.print(F(" ms\r\n Dispatches: "));
+  Serial.print(statDispatches);
+  Serial.print(F(" ("));
+  Serial.print(statDispatches / seconds, 0);
+  Serial.print(F("/s)\r\n Tokens: "));
+  Serial.print(statTokens);
+  Serial.print(F(" ("));
+  Serial.print(statTokens / seconds, 0);
+  Serial.print(F("/s)\r\n Forth Space: "));
+  Serial.print((size_t)pStatPeakHere - (size_t)forthSpace);
+  Serial.print(F(" of "));
+  Serial.print(FORTH_SIZE * sizeof(cell_t));
+  Serial.print(F(" Bytes\r\n Data Stack: "));
+  for (depth = STACK_SIZE; depth && stack[depth - 1] == STAT_PAINT; depth--);
+  Serial.print(depth);
+  Serial.print(F(" of "));
+  Serial.print(STACK_SIZE);
+  Serial.print(F(" Cells\r\n Return Stack: "));
+  for (depth = RSTACK_SIZE; depth && rStack[depth - 1] == STAT_PAINT; depth--);
+  Serial.print(depth);
+  Serial.print(F(" of "));
+  Serial.print(RSTACK_SIZE);
+  Serial.println(F(" Cells"));
+}
+#endif
+
+/********************************************************************************/
+/**                               Profiler                                     **/
+/********************************************************************************/
+#ifdef EN_PROFILE
+const PROGMEM char profile_on_str[] = "profile-on";
+// ( -- )
+// Start counting calls and self time of the words run by executeWord().
+void _profile_on(void) {
+  profileOwner = 0;
+  profileLast = micros();
+  profiling = true;
+}
+
+const PROGMEM char profile_off_str[] = "profile-off";
+// ( -- )
+// Stop profiling. The counts are kept for .PROFILE.
+void _profile_off(void) {
+  profiling = false;
+}
+
+const PROGMEM char profile_reset_str[] = "profile-reset";
+// ( -- )
+// Clear the counts.
+void _profile_reset(void) {
+  memset(profile, 0, sizeof(profile));
+  memset(&profileOther, 0, sizeof(profileOther));
+  profileLast = micros();
+}
+
+/********************************************************************************/
+/** Print the PROFILE_TOP slots with the most calls, or the most self time.    **/
+/********************************************************************************/
+void printProfile(bool byCalls) {
+  uint8_t order[PROFILE_SIZE];
+  uint8_t used = 0;
+  uint8_t i, j, k;
+
+  for (i = 0; i < PROFILE_SIZE; i++) {
+    if (profile[i].xt) order[used++] = i;
+  }
+  for (i = 0; i < used && i < PROFILE_TOP; i++) {
+    k = i;
+    for (j = i + 1; j < used; j++) {
+      if (byCalls ? profile[order[j]].calls > profile[order[k]].calls
+                  : profile[order[j]].time > profile[order[k]].time) k = j;
+    }
+    j = order[i];
+    order[i] = order[k];
+    order[k] = j;
+    Serial.print(F(" "));
+    Serial.print(profile[order[i]].time);
+    Serial.print(F("\t\t"));
+    Serial.print(profile[order[i]].calls);
+    Serial.print(F("\t\t"));
+    xtToName(profile[order[i]].xt);
+    Serial.println();
+  }
+}
+
+const PROGMEM char dot_profile_str[] = ".profile";
+// ( -- )
+// Display the words with the most self time and the words called most often.
+void _dot_profile(void) {
+  Serial.print(F("\r\n Self us\t\tCalls\t\tWord (by self time)\r\n"));
+  printProfile(false);
+  Serial.print(F(" Self us\t\tCalls\t\tWord (by calls)\r\n"));
+  printProfile(true);
+  if (profileOther.calls) {
+    Serial.print(F(" "));
+    Serial.print(profileOther.time);
+    Serial.print(F("\t\t"));
+    Serial.print(profileOther.calls);
+    Serial.println(F("\t\tOther words"));
+  }
+}
+#endif
+
 /*********************************************************************************/
 /**                         Dictionary Initialization                           **/
 /*********************************************************************************/
-const PROGMEM flashEntry_t flashDict[] = {
+constexpr PROGMEM flashEntry_t flashDict[] = {
   /*****************************************************/
   /* The initial entries must stay in this order so    */
   /* they always have the same index. They get called  */
   /* referenced when compiling code                    */
   /*****************************************************/
-  { exit_str,           _exit,            NORMAL },
-  { literal_str,        _literal,         IMMEDIATE },
-  { type_str,           _type,            NORMAL },
-  { jump_str,           _jump,            SMUDGE },
-  { zjump_str,          _zjump,           SMUDGE },
-  { subroutine_str,     _subroutine,      SMUDGE },
-  { throw_str,          _throw,           NORMAL },
-  { do_sys_str,         _do_sys,          SMUDGE },
-  { loop_sys_str,       _loop_sys,        SMUDGE },
-  { leave_sys_str,      _leave_sys,       SMUDGE },
-  { plus_loop_sys_str,  _plus_loop_sys,   SMUDGE },
-  { evaluate_str,       _evaluate,        NORMAL },
-  { s_quote_str,        _s_quote,         IMMEDIATE + COMP_ONLY },
-  { dot_quote_str,      _dot_quote,       IMMEDIATE + COMP_ONLY },
-  { variable_str,       _variable,        NORMAL },
-  { over_str,           _over,            NORMAL }, // CAL
-  { eq_str,             _eq,              NORMAL }, // CAL
-  { drop_str,           _drop,            NORMAL }, // CAL
+  { exit_str,           _exit,            NORMAL,           NO_EFFECT },
+  { literal_str,        _literal,         IMMEDIATE,        NO_EFFECT },
+  { type_str,           _type,            NORMAL,           NO_EFFECT },
+  { jump_str,           _jump,            SMUDGE,           NO_EFFECT },
+  { zjump_str,          _zjump,           SMUDGE,           NO_EFFECT },
+  { subroutine_str,     _subroutine,      SMUDGE,           NO_EFFECT },
+  { throw_str,          _throw,           NORMAL,           NO_EFFECT },
+  { do_sys_str,         _do_sys,          SMUDGE,           NO_EFFECT },
+  { loop_sys_str,       _loop_sys,        SMUDGE,           NO_EFFECT },
+  { leave_sys_str,      _leave_sys,       SMUDGE,           NO_EFFECT },
+  { plus_loop_sys_str,  _plus_loop_sys,   SMUDGE,           NO_EFFECT },
+  { evaluate_str,       _evaluate,        NORMAL,           NO_EFFECT },
+  { s_quote_str,        _s_quote,         IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { dot_quote_str,      _dot_quote,       IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { variable_str,       _variable,        NORMAL,           NO_EFFECT },
+  { over_str,           _over,            NORMAL,           EFFECT(2, 3) }, // CAL
+  { eq_str,             _eq,              NORMAL,           EFFECT(2, 1) }, // CAL
+  { drop_str,           _drop,            NORMAL,           EFFECT(1, 0) }, // CAL
+  { plus_str,           _plus,            NORMAL,           EFFECT(2, 1) },
+  { fetch_str,          _fetch,           NORMAL,           EFFECT(1, 1) },
+  { store_str,          _store,           NORMAL,           EFFECT(2, 0) },
+  { dupe_str,           _dupe,            NORMAL,           EFFECT(1, 2) },
+  { r_fetch_str,        _r_fetch,         NORMAL,           EFFECT(0, 1) },
+
+  /*****************************************************/
+  /* Fused primitives, see compileWord(). Also fixed.  */
+  /*****************************************************/
+  { lit_plus_str,       _lit_plus,        SMUDGE,           EFFECT(1, 1) },
+  { fetch_plus_str,     _fetch_plus,      SMUDGE,           EFFECT(2, 1) },
+  { r_fetch_fetch_str,  _r_fetch_fetch,   SMUDGE,           EFFECT(0, 1) },
+  { dup_zjump_str,      _dup_zjump,       SMUDGE,           EFFECT(1, 1) },
+  { lit_eq_zjump_str,   _lit_eq_zjump,    SMUDGE,           EFFECT(1, 0) },
+  { over_eq_zjump_str,  _over_eq_zjump,   SMUDGE,           EFFECT(2, 1) },
+  { lit_of_str,         _lit_of,          SMUDGE,           EFFECT(1, 1) },
+
+  /*****************************************************/
+  /* Hidden run-time primitives. Also fixed.           */
+  /*****************************************************/
+  { forget_sys_str,     _forget_sys,      SMUDGE,           NO_EFFECT },
+
+  /*****************************************************/
+  /* Loop run-time, see executeWord(). Also fixed.     */
+  /*****************************************************/
+  { qdo_sys_str,        _qdo_sys,         SMUDGE,           NO_EFFECT },
+  { for_sys_str,        _for_sys,         SMUDGE,           NO_EFFECT },
+  { next_sys_str,       _next_sys,        SMUDGE,           NO_EFFECT },
+  { i_str,              _i,               NORMAL,           EFFECT(0, 1) },
+  { j_str,              _j,               NORMAL,           EFFECT(0, 1) },
 
   /*****************************************************/
   /* Order does not matter after here                  */
   /* Core Words                                        */
   /*****************************************************/
-  { abort_str,          _abort,           NORMAL },
-  { store_str,          _store,           NORMAL },
-  { number_sign_str,    _number_sign,     NORMAL },
-  { number_sign_gt_str, _number_sign_gt,  NORMAL },
-  { number_sign_s_str,  _number_sign_s,   NORMAL },
-  { tick_str,           _tick,            NORMAL },
-  { paren_str,          _paren,           IMMEDIATE },
-  { star_str,           _star,            NORMAL },
-  { star_slash_str,     _star_slash,      NORMAL },
-  { star_slash_mod_str, _star_slash_mod,  NORMAL },
-  { plus_str,           _plus,            NORMAL },
-  { plus_store_str,     _plus_store,      NORMAL },
-  { plus_loop_str,      _plus_loop,       IMMEDIATE + COMP_ONLY },
-  { comma_str,          _comma,           NORMAL },
-  { minus_str,          _minus,           NORMAL },
-  { dot_str,            _dot,             NORMAL },
-  { slash_str,          _slash,           NORMAL },
-  { slash_mod_str,      _slash_mod,       NORMAL },
-  { zero_less_str,      _zero_less,       NORMAL },
-  { zero_equal_str,     _zero_equal,      NORMAL },
-  { one_plus_str,       _one_plus,        NORMAL },
-  { one_minus_str,      _one_minus,       NORMAL },
-  { two_store_str,      _two_store,       NORMAL },
-  { two_star_str,       _two_star,        NORMAL },
-  { two_slash_str,      _two_slash,       NORMAL },
-  { two_fetch_str,      _two_fetch,       NORMAL },
-  { two_drop_str,       _two_drop,        NORMAL },
-  { two_dup_str,        _two_dup,         NORMAL },
-  { two_over_str,       _two_over,        NORMAL },
-  { two_swap_str,       _two_swap,        NORMAL },
-  { colon_str,          _colon,           NORMAL },
-  { semicolon_str,      _semicolon,       IMMEDIATE },
-  { lt_str,             _lt,              NORMAL },
-  { lt_number_sign_str, _lt_number_sign,  NORMAL },
-  { eq_str,             _eq,              NORMAL },
-  { gt_str,             _gt,              NORMAL },
-  { to_body_str,        _to_body,         NORMAL },
-  { to_in_str,          _to_in,           NORMAL },
-  { to_number_str,      _to_number,       NORMAL },
-  { to_r_str,           _to_r,            NORMAL },
-  { question_dup_str,   _question_dup,    NORMAL },
-  { fetch_str,          _fetch,           NORMAL },
-  { abort_quote_str,    _abort_quote,     IMMEDIATE + COMP_ONLY },
-  { abs_str,            _abs,             NORMAL },
-  { accept_str,         _accept,          NORMAL },
-  { align_str,          _align,           NORMAL },
-  { aligned_str,        _aligned,         NORMAL },
-  { allot_str,          _allot,           NORMAL },
-  { and_str,            _and,             NORMAL },
-  { base_str,           _base,            NORMAL },
-  { begin_str,          _begin,           IMMEDIATE + COMP_ONLY },
-  { bl_str,             _bl,              NORMAL },
-  { c_store_str,        _c_store,         NORMAL },
-  { c_comma_str,        _c_comma,         NORMAL },
-  { c_fetch_str,        _c_fetch,         NORMAL },
-  { cell_plus_str,      _cell_plus,       NORMAL },
-  { cells_str,          _cells,           NORMAL },
-  { char_str,           _char,            NORMAL },
-  { char_plus_str,      _char_plus,       NORMAL },
-  { chars_str,          _chars,           NORMAL },
-  { constant_str,       _constant,        NORMAL },
-  { count_str,          _count,           NORMAL },
-  { cr_str,             _cr,              NORMAL },
-  { create_str,         _create,          NORMAL },
-  { decimal_str,        _decimal,         NORMAL },
-  { depth_str,          _depth,           NORMAL },
-  { do_str,             _do,              IMMEDIATE + COMP_ONLY },
-  { does_str,           _does,            IMMEDIATE + COMP_ONLY },
-  { drop_str,           _drop,            NORMAL },
-  { dupe_str,           _dupe,            NORMAL },
-  { else_str,           _else,            IMMEDIATE + COMP_ONLY },
-  { emit_str,           _emit,            NORMAL },
-  { environment_str,    _environment,     NORMAL },
-  { execute_str,        _execute,         NORMAL },
-  { fill_str,           _fill,            NORMAL },
-  { find_str,           _find,            NORMAL },
-  { fm_slash_mod_str,   _fm_slash_mod,    NORMAL },
-  { here_str,           _here,            NORMAL },
-  { hold_str,           _hold,            NORMAL },
-  { i_str,              _i,               NORMAL },
-  { if_str,             _if,              IMMEDIATE + COMP_ONLY },
-  { immediate_str,      _immediate,       NORMAL },
-  { invert_str,         _invert,          NORMAL },
-  { j_str,              _j,               NORMAL },
-  { key_str,            _key,             NORMAL },
-  { leave_str,          _leave,           IMMEDIATE + COMP_ONLY },
-  { loop_str,           _loop,            IMMEDIATE + COMP_ONLY },
-  { lshift_str,         _lshift,          NORMAL },
-  { m_star_str,         _m_star,          NORMAL },
-  { max_str,            _max,             NORMAL },
-  { min_str,            _min,             NORMAL },
-  { mod_str,            _mod,             NORMAL },
-  { move_str,           _move,            NORMAL },
-  { negate_str,         _negate,          NORMAL },
-  { or_str,             _or,              NORMAL },
-  { over_str,           _over,            NORMAL },
-  { postpone_str,       _postpone,        IMMEDIATE + COMP_ONLY },
-  { quit_str,           _quit,            NORMAL },
-  { r_from_str,         _r_from,          NORMAL },
-  { r_fetch_str,        _r_fetch,         NORMAL },
-  { recurse_str,        _recurse,         IMMEDIATE + COMP_ONLY },
-  { repeat_str,         _repeat,          IMMEDIATE + COMP_ONLY },
-  { rot_str,            _rot,             NORMAL },
-  { rshift_str,         _rshift,          NORMAL },
-  { s_to_d_str,         _s_to_d,          NORMAL },
-  { sign_str,           _sign,            NORMAL },
-  { sm_slash_rem_str,   _sm_slash_rem,    NORMAL },
-  { source_str,         _source,          NORMAL },
-  { space_str,          _space,           NORMAL },
-  { spaces_str,         _spaces,          NORMAL },
-  { state_str,          _state,           NORMAL },
-  { swap_str,           _swap,            NORMAL },
-  { then_str,           _then,            IMMEDIATE + COMP_ONLY },
-  { u_dot_str,          _u_dot,           NORMAL },
-  { u_lt_str,           _u_lt,            NORMAL },
-  { um_star_str,        _um_star,         NORMAL },
-  { um_slash_mod_str,   _um_slash_mod,    NORMAL },
-  { unloop_str,         _unloop,          NORMAL + COMP_ONLY },
-  { until_str,          _until,           IMMEDIATE + COMP_ONLY },
-  { while_str,          _while,           IMMEDIATE + COMP_ONLY },
-  { word_str,           _word,            NORMAL },
-  { xor_str,            _xor,             NORMAL },
-  { left_bracket_str,   _left_bracket,    IMMEDIATE },
-  { bracket_tick_str,   _bracket_tick,    IMMEDIATE },
-  { bracket_char_str,   _bracket_char,    IMMEDIATE },
-  { right_bracket_str,  _right_bracket,   NORMAL },
+  { abort_str,          _abort,           NORMAL,           NO_EFFECT },
+  { number_sign_str,    _number_sign,     NORMAL,           NO_EFFECT },
+  { number_sign_gt_str, _number_sign_gt,  NORMAL,           EFFECT(2, 2) },
+  { number_sign_s_str,  _number_sign_s,   NORMAL,           NO_EFFECT },
+  { tick_str,           _tick,            NORMAL,           NO_EFFECT },
+  { paren_str,          _paren,           IMMEDIATE,        NO_EFFECT },
+  { star_str,           _star,            NORMAL,           EFFECT(2, 1) },
+  { star_slash_str,     _star_slash,      NORMAL,           NO_EFFECT },
+  { star_slash_mod_str, _star_slash_mod,  NORMAL,           NO_EFFECT },
+  { plus_store_str,     _plus_store,      NORMAL,           NO_EFFECT },
+  { plus_loop_str,      _plus_loop,       IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { comma_str,          _comma,           NORMAL,           NO_EFFECT },
+  { minus_str,          _minus,           NORMAL,           EFFECT(2, 1) },
+  { dot_str,            _dot,             NORMAL,           NO_EFFECT },
+  { slash_str,          _slash,           NORMAL,           EFFECT(2, 1) },
+  { slash_mod_str,      _slash_mod,       NORMAL,           NO_EFFECT },
+  { zero_less_str,      _zero_less,       NORMAL,           EFFECT(1, 1) },
+  { zero_equal_str,     _zero_equal,      NORMAL,           EFFECT(1, 1) },
+  { one_plus_str,       _one_plus,        NORMAL,           EFFECT(1, 1) },
+  { one_minus_str,      _one_minus,       NORMAL,           EFFECT(1, 1) },
+  { two_store_str,      _two_store,       NORMAL,           NO_EFFECT },
+  { two_star_str,       _two_star,        NORMAL,           EFFECT(1, 1) },
+  { two_slash_str,      _two_slash,       NORMAL,           EFFECT(1, 1) },
+  { two_fetch_str,      _two_fetch,       NORMAL,           NO_EFFECT },
+  { two_drop_str,       _two_drop,        NORMAL,           EFFECT(2, 0) },
+  { two_dup_str,        _two_dup,         NORMAL,           NO_EFFECT },
+  { two_over_str,       _two_over,        NORMAL,           NO_EFFECT },
+  { two_swap_str,       _two_swap,        NORMAL,           NO_EFFECT },
+  { colon_str,          _colon,           NORMAL,           NO_EFFECT },
+  { semicolon_str,      _semicolon,       IMMEDIATE,        NO_EFFECT },
+  { lt_str,             _lt,              NORMAL,           EFFECT(2, 1) },
+  { lt_number_sign_str, _lt_number_sign,  NORMAL,           NO_EFFECT },
+  { eq_str,             _eq,              NORMAL,           EFFECT(2, 1) },
+  { gt_str,             _gt,              NORMAL,           EFFECT(2, 1) },
+  { to_body_str,        _to_body,         NORMAL,           NO_EFFECT },
+  { to_in_str,          _to_in,           NORMAL,           NO_EFFECT },
+  { to_number_str,      _to_number,       NORMAL,           NO_EFFECT },
+  { to_r_str,           _to_r,            NORMAL,           NO_EFFECT },
+  { question_dup_str,   _question_dup,    NORMAL,           NO_EFFECT },
+  { abort_quote_str,    _abort_quote,     IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { abs_str,            _abs,             NORMAL,           EFFECT(1, 1) },
+  { accept_str,         _accept,          NORMAL,           NO_EFFECT },
+  { align_str,          _align,           NORMAL,           NO_EFFECT },
+  { aligned_str,        _aligned,         NORMAL,           NO_EFFECT },
+  { allot_str,          _allot,           NORMAL,           NO_EFFECT },
+  { and_str,            _and,             NORMAL,           EFFECT(2, 1) },
+  { base_str,           _base,            NORMAL,           NO_EFFECT },
+  { begin_str,          _begin,           IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { bl_str,             _bl,              NORMAL,           NO_EFFECT },
+  { c_store_str,        _c_store,         NORMAL,           EFFECT(2, 0) },
+  { c_comma_str,        _c_comma,         NORMAL,           NO_EFFECT },
+  { c_fetch_str,        _c_fetch,         NORMAL,           EFFECT(1, 1) },
+  { cell_plus_str,      _cell_plus,       NORMAL,           EFFECT(1, 1) },
+  { cells_str,          _cells,           NORMAL,           EFFECT(1, 1) },
+  { char_str,           _char,            NORMAL,           NO_EFFECT },
+  { char_plus_str,      _char_plus,       NORMAL,           EFFECT(1, 1) },
+  { chars_str,          _chars,           NORMAL,           NO_EFFECT },
+  { constant_str,       _constant,        NORMAL,           NO_EFFECT },
+  { count_str,          _count,           NORMAL,           NO_EFFECT },
+  { cr_str,             _cr,              NORMAL,           NO_EFFECT },
+  { create_str,         _create,          NORMAL,           NO_EFFECT },
+  { decimal_str,        _decimal,         NORMAL,           NO_EFFECT },
+  { depth_str,          _depth,           NORMAL,           NO_EFFECT },
+  { do_str,             _do,              IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { does_str,           _does,            IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { drop_str,           _drop,            NORMAL,           EFFECT(1, 0) },
+  { else_str,           _else,            IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { emit_str,           _emit,            NORMAL,           NO_EFFECT },
+  { environment_str,    _environment,     NORMAL,           NO_EFFECT },
+  { execute_str,        _execute,         NORMAL,           NO_EFFECT },
+  { fill_str,           _fill,            NORMAL,           NO_EFFECT },
+  { find_str,           _find,            NORMAL,           NO_EFFECT },
+  { fm_slash_mod_str,   _fm_slash_mod,    NORMAL,           NO_EFFECT },
+  { here_str,           _here,            NORMAL,           NO_EFFECT },
+  { hold_str,           _hold,            NORMAL,           NO_EFFECT },
+  { if_str,             _if,              IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { immediate_str,      _immediate,       NORMAL,           NO_EFFECT },
+  { invert_str,         _invert,          NORMAL,           EFFECT(1, 1) },
+  { key_str,            _key,             NORMAL,           NO_EFFECT },
+  { leave_str,          _leave,           IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { loop_str,           _loop,            IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { lshift_str,         _lshift,          NORMAL,           EFFECT(2, 1) },
+  { m_star_str,         _m_star,          NORMAL,           NO_EFFECT },
+  { max_str,            _max,             NORMAL,           EFFECT(2, 1) },
+  { min_str,            _min,             NORMAL,           EFFECT(2, 1) },
+  { mod_str,            _mod,             NORMAL,           NO_EFFECT },
+  { move_str,           _move,            NORMAL,           NO_EFFECT },
+  { negate_str,         _negate,          NORMAL,           EFFECT(1, 1) },
+  { or_str,             _or,              NORMAL,           EFFECT(2, 1) },
+  { over_str,           _over,            NORMAL,           EFFECT(2, 3) },
+  { postpone_str,       _postpone,        IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { quit_str,           _quit,            NORMAL,           NO_EFFECT },
+  { r_from_str,         _r_from,          NORMAL,           NO_EFFECT },
+  { recurse_str,        _recurse,         IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { repeat_str,         _repeat,          IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { rot_str,            _rot,             NORMAL,           EFFECT(3, 3) },
+  { rshift_str,         _rshift,          NORMAL,           EFFECT(2, 1) },
+  { s_to_d_str,         _s_to_d,          NORMAL,           NO_EFFECT },
+  { sign_str,           _sign,            NORMAL,           NO_EFFECT },
+  { sm_slash_rem_str,   _sm_slash_rem,    NORMAL,           NO_EFFECT },
+  { source_str,         _source,          NORMAL,           NO_EFFECT },
+  { space_str,          _space,           NORMAL,           NO_EFFECT },
+  { spaces_str,         _spaces,          NORMAL,           NO_EFFECT },
+  { state_str,          _state,           NORMAL,           NO_EFFECT },
+  { swap_str,           _swap,            NORMAL,           EFFECT(2, 2) },
+  { then_str,           _then,            IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { u_dot_str,          _u_dot,           NORMAL,           NO_EFFECT },
+  { u_lt_str,           _u_lt,            NORMAL,           EFFECT(2, 1) },
+  { um_star_str,        _um_star,         NORMAL,           NO_EFFECT },
+  { um_slash_mod_str,   _um_slash_mod,    NORMAL,           NO_EFFECT },
+  { unloop_str,         _unloop,          NORMAL + COMP_ONLY, NO_EFFECT },
+  { until_str,          _until,           IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { while_str,          _while,           IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { word_str,           _word,            NORMAL,           NO_EFFECT },
+  { xor_str,            _xor,             NORMAL,           EFFECT(2, 1) },
+  { left_bracket_str,   _left_bracket,    IMMEDIATE,        NO_EFFECT },
+  { bracket_tick_str,   _bracket_tick,    IMMEDIATE,        NO_EFFECT },
+  { bracket_char_str,   _bracket_char,    IMMEDIATE,        NO_EFFECT },
+  { right_bracket_str,  _right_bracket,   NORMAL,           NO_EFFECT },
 
 #ifdef CORE_EXT_SET
-  { dot_paren_str,      _dot_paren,       IMMEDIATE },
-  { zero_not_equal_str, _zero_not_equal,  NORMAL },
-  { zero_greater_str,   _zero_greater,    NORMAL },
-  { two_to_r_str,       _two_to_r,        NORMAL },
-  { two_r_from_str,     _two_r_from,      NORMAL },
-  { two_r_fetch_str,    _two_r_fetch,     NORMAL },
-  { neq_str,            _neq,             NORMAL },
-  { hex_str,            _hex,             NORMAL },
-  { case_str,           _case,            IMMEDIATE + COMP_ONLY },    // CAL
-  { of_str,             _of,              IMMEDIATE + COMP_ONLY },    // CAL
-  { endof_str,          _endof,           IMMEDIATE + COMP_ONLY },    // CAL
-  { endcase_str,        _endcase,         IMMEDIATE + COMP_ONLY },    // CAL
+  { dot_paren_str,      _dot_paren,       IMMEDIATE,        NO_EFFECT },
+  { zero_not_equal_str, _zero_not_equal,  NORMAL,           EFFECT(1, 1) },
+  { zero_greater_str,   _zero_greater,    NORMAL,           EFFECT(1, 1) },
+  { two_to_r_str,       _two_to_r,        NORMAL,           EFFECT(2, 0) },
+  { two_r_from_str,     _two_r_from,      NORMAL,           NO_EFFECT },
+  { two_r_fetch_str,    _two_r_fetch,     NORMAL,           NO_EFFECT },
+  { neq_str,            _neq,             NORMAL,           EFFECT(2, 1) },
+  { hex_str,            _hex,             NORMAL,           NO_EFFECT },
+  { case_str,           _case,            IMMEDIATE + COMP_ONLY, NO_EFFECT },    // CAL
+  { of_str,             _of,              IMMEDIATE + COMP_ONLY, NO_EFFECT },    // CAL
+  { endof_str,          _endof,           IMMEDIATE + COMP_ONLY, NO_EFFECT },    // CAL
+  { endcase_str,        _endcase,         IMMEDIATE + COMP_ONLY, NO_EFFECT },    // CAL
+  { marker_str,         _marker,          NORMAL,           NO_EFFECT },
+  { question_do_str,    _question_do,     IMMEDIATE + COMP_ONLY, NO_EFFECT },
+#endif
+
+#ifdef BLOCK_SET
+  { blk_str,            _blk,             NORMAL,           NO_EFFECT },
+  { block_str,          _block,           NORMAL,           NO_EFFECT },
+  { buffer_str,         _buffer,          NORMAL,           NO_EFFECT },
+  { empty_buffers_str,  _empty_buffers,   NORMAL,           NO_EFFECT },
+  { flush_str,          _flush,           NORMAL,           NO_EFFECT },
+  { list_str,           _list,            NORMAL,           NO_EFFECT },
+  { load_str,           _load,            NORMAL,           NO_EFFECT },
+  { save_buffers_str,   _save_buffers,    NORMAL,           NO_EFFECT },
+  { scr_str,            _scr,             NORMAL,           NO_EFFECT },
+  { update_str,         _update,          NORMAL,           NO_EFFECT },
 #endif
 
 #ifdef DOUBLE_SET
@@ -2757,7 +3516,7 @@ const PROGMEM flashEntry_t flashDict[] = {
 #endif
 
 #ifdef FACILITY_SET
-  { key_question_str,   _key_question,    NORMAL },
+  { key_question_str,   _key_question,    NORMAL,           NO_EFFECT },
 #endif
 
 #ifdef LOCALS_SET
@@ -2767,10 +3526,11 @@ const PROGMEM flashEntry_t flashDict[] = {
 #endif
 
 #ifdef TOOLS_SET
-  { dot_s_str,          _dot_s,           NORMAL },
-  { dump_str,           _dump,            NORMAL },
-  { see_str,            _see,             NORMAL },
-  { words_str,          _words,           NORMAL },
+  { dot_s_str,          _dot_s,           NORMAL,           NO_EFFECT },
+  { dump_str,           _dump,            NORMAL,           NO_EFFECT },
+  { forget_str,         _forget,          NORMAL,           NO_EFFECT },
+  { see_str,            _see,             NORMAL,           NO_EFFECT },
+  { words_str,          _words,           NORMAL,           NO_EFFECT },
 #endif
 
 #ifdef SEARCH_SET
@@ -2780,26 +3540,143 @@ const PROGMEM flashEntry_t flashDict[] = {
 #endif
 
 #ifdef EN_ARDUINO_OPS
-  { freeMem_str,        _freeMem,         NORMAL },
-  { delay_str,          _delay,           NORMAL },
-  { pinWrite_str,       _pinWrite,        NORMAL },
-  { pinMode_str,        _pinMode,         NORMAL },
-  { pinRead_str,        _pinRead,         NORMAL },
-  { analogRead_str,     _analogRead,      NORMAL },
-  { analogWrite_str,    _analogWrite,     NORMAL },
-  { to_name_str,        _toName,          NORMAL },
+  { freeMem_str,        _freeMem,         NORMAL,           NO_EFFECT },
+  { delay_str,          _delay,           NORMAL,           NO_EFFECT },
+  { ms_str,             _delay,           NORMAL,           NO_EFFECT },
+  { millis_str,         _millis,          NORMAL,           NO_EFFECT },
+  { micros_str,         _micros,          NORMAL,           NO_EFFECT },
+  { pinWrite_str,       _pinWrite,        NORMAL,           NO_EFFECT },
+  { pinMode_str,        _pinMode,         NORMAL,           NO_EFFECT },
+  { pinRead_str,        _pinRead,         NORMAL,           NO_EFFECT },
+  { analogRead_str,     _analogRead,      NORMAL,           NO_EFFECT },
+  { analogWrite_str,    _analogWrite,     NORMAL,           NO_EFFECT },
+  { to_name_str,        _toName,          NORMAL,           NO_EFFECT },
 #endif
 
 #ifdef EN_EEPROM_OPS
-  { eeRead_str,         _eeprom_read,     NORMAL },
-  { eeWrite_str,        _eeprom_write,    NORMAL },
-  { eeDump_str,         _eeprom_dump,     NORMAL },
-  { eeClear_str,        _eeprom_clear,    NORMAL },
-  { eeload_str,         _eeLoad,          NORMAL },
-  { eeInterpret_str,    _eeInterpret,     NORMAL },
+  { eeRead_str,         _eeprom_read,     NORMAL,           NO_EFFECT },
+  { eeWrite_str,        _eeprom_write,    NORMAL,           NO_EFFECT },
+  { eeDump_str,         _eeprom_dump,     NORMAL,           NO_EFFECT },
+  { eeClear_str,        _eeprom_clear,    NORMAL,           NO_EFFECT },
+  { eeload_str,         _eeLoad,          NORMAL,           NO_EFFECT },
+  { eeInterpret_str,    _eeInterpret,     NORMAL,           NO_EFFECT },
+  { saveImage_str,      _save_image,      NORMAL,           NO_EFFECT },
+  { loadImage_str,      _load_image,      NORMAL,           NO_EFFECT },
+  { eeWear_str,         _eeWear,          NORMAL,           NO_EFFECT },
+#endif
+
+  { task_str,           _task,            NORMAL,           NO_EFFECT },
+  { start_str,          _start,           NORMAL,           NO_EFFECT },
+  { pause_str,          _pause,           NORMAL,           NO_EFFECT },
+  { stop_str,           _stop,            NORMAL,           NO_EFFECT },
+
+  { for_str,            _for,             IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { next_str,           _next,            IMMEDIATE + COMP_ONLY, NO_EFFECT },
+  { inline_str,         _inline,          NORMAL,           NO_EFFECT },
+  { inline_limit_str,   _inline_limit,    NORMAL,           NO_EFFECT },
+  { private_str,        _private,         NORMAL,           NO_EFFECT },
+  { public_str,         _public,          NORMAL,           NO_EFFECT },
+  { seal_str,           _seal,            NORMAL,           NO_EFFECT },
+#ifdef EN_BENCH_STATS
+  { dot_stats_str,      _dot_stats,       NORMAL,           NO_EFFECT },
+#endif
+#ifdef EN_PROFILE
+  { profile_on_str,     _profile_on,      NORMAL,           NO_EFFECT },
+  { profile_off_str,    _profile_off,     NORMAL,           NO_EFFECT },
+  { profile_reset_str,  _profile_reset,   NORMAL,           NO_EFFECT },
+  { dot_profile_str,    _dot_profile,     NORMAL,           NO_EFFECT },
 #endif
 
-  { NULL,           NULL,    NORMAL }
+  { NULL,           NULL,    NORMAL, NO_EFFECT }
 };
 
+/*********************************************************************************/
+/**                         Dictionary Hash Table                               **/
+/**  Built by the compiler from flashDict[] and stored in flash. bucket[] holds **/
+/**  the XT of the first word in each bucket and chain[] the XT of the next     **/
+/**  word in the same bucket. Chains run in dictionary order so the first match **/
+/**  is the one a linear search would find. An XT of 0 ends a chain. length[]   **/
+/**  holds the length of each name, which findFlashEntry() compares first.      **/
+/*********************************************************************************/
+#define FLASH_WORDS (sizeof(flashDict) / sizeof(flashEntry_t) - 1)
+static_assert(FLASH_WORDS < 256, "primitive XTs must fit in 8 bits");
+
+constexpr uint8_t nameHash(const char* name, uint8_t hash) {
+  return *name ? nameHash(name + 1, HASH_STEP(hash, *name)) : hash;
+}
+
+constexpr uint8_t flashBucketOf(unsigned index) {
+  return nameHash(flashDict[index].name, 0) & (FLASH_BUCKETS - 1);
+}
+
+// XT of the first word at or after index that falls in bucket, or 0
+constexpr uint8_t firstInBucket(unsigned bucket, unsigned index) {
+  return index >= FLASH_WORDS ? 0 :
+         flashBucketOf(index) == bucket ? index + 1 :
+         firstInBucket(bucket, index + 1);
+}
+
+template <unsigned... I> struct indexList {};
+template <unsigned N, unsigned... I>
+struct makeIndexList : makeIndexList<N - 1, N - 1, I...> {};
+template <unsigned... I>
+struct makeIndexList<0, I...> { typedef indexList<I...> type; };
+
+constexpr uint8_t nameLength(const char* name) {
+  return *name ? nameLength(name + 1) + 1 : 0;
+}
+
+typedef struct {
+  uint8_t bucket[FLASH_BUCKETS];
+  uint8_t chain[FLASH_WORDS];
+  uint8_t length[FLASH_WORDS];
+} flashHash_t;
+
+template <typename B, typename C> struct flashHashBuilder;
+template <unsigned... B, unsigned... C>
+struct flashHashBuilder<indexList<B...>, indexList<C...> > {
+  static constexpr flashHash_t build(void) {
+    return { { firstInBucket(B, 0)... },
+             { firstInBucket(flashBucketOf(C), C + 1)... },
+             { nameLength(flashDict[C].name)... } };
+  }
+};
+
+constexpr PROGMEM flashHash_t flashHash =
+  flashHashBuilder<makeIndexList<FLASH_BUCKETS>::type,
+                   makeIndexList<FLASH_WORDS>::type>::build();
 
+/*********************************************************************************/
+/** Signature of flashDict[] kept in a dictionary image. It changes when a word **/
+/** is added, removed, renamed or moved, or with the cell size, as any of these **/
+/** would give the XTs in a saved image another meaning.                        **/
+/*********************************************************************************/
+constexpr uint16_t flashSignature(unsigned index, uint16_t sig) {
+  return index >= FLASH_WORDS ? sig :
+         flashSignature(index + 1, (uint16_t)((sig << 3) | (sig >> 13)) ^
+                                   nameHash(flashDict[index].name, 0));
+}
+
+uint16_t flashVersion(void) {
+  static constexpr uint16_t version =
+    flashSignature(0, FLASH_WORDS * sizeof(cell_t));
+  return version;
+}
+
+/******************************************************************************/
+/** Search the flash dictionary for the length characters at name, whose    **/
+/** hashName() is hash. Names of another length are passed over unread.      **/
+/** Returns the XT of the first match or 0 if there is none.                 **/
+/******************************************************************************/
+uint8_t findFlashEntry(const char* name, uint8_t length, uint8_t hash) {
+  uint8_t xt = pgm_read_byte(&flashHash.bucket[hash & (FLASH_BUCKETS - 1)]);
+  while (xt) {
+    if (pgm_read_byte(&flashHash.length[xt - 1]) == length &&
+        !strncasecmp_P(name, (char*)pgm_read_ptr(&flashDict[xt - 1].name),
+                       length)) {
+      return xt;
+    }
+    xt = pgm_read_byte(&flashHash.chain[xt - 1]);
+  }
+  return 0;
+}
@@ -84,7 +84,7 @@
 /**  -58 [IF], [ELSE], or [THEN] exception                                   **/
 
 typedef struct {
-  const int code;
+  const int16_t code;              // Read with pgm_read_word()
   const char* name;
 } exception_t;
 
@@ -97,14 +97,21 @@ const char error_5_str[] PROGMEM = "Return Stack Overflow";
 const char error_6_str[] PROGMEM = "Return Stack Underflow";
 const char error_9_str[] PROGMEM = "Invalid Address";
 const char error_10_str[] PROGMEM = "Divide by Zero";
+const char error_12_str[] PROGMEM = "Argument Type Mismatch";
 const char error_13_str[] PROGMEM = "Undefined Word";
 const char error_14_str[] PROGMEM = "Interpreting a Compile-Only Word";
 const char error_16_str[] PROGMEM = "Attempt to use zero-length string as a name";
 const char error_18_str[] PROGMEM = "Parsed string overflow";
+const char error_19_str[] PROGMEM = "Definition Name Too Long";
+const char error_21_str[] PROGMEM = "Unsupported Operation";
 const char error_22_str[] PROGMEM = "Control Structure Mismatch";
 const char error_23_str[] PROGMEM = "Address Alignment Exception";
 const char error_31_str[] PROGMEM = ">BODY used on non-CREATEd definition";
 const char error_32_str[] PROGMEM = "Invalid Name Argument";
+const char error_33_str[] PROGMEM = "Block Read Exception";
+const char error_34_str[] PROGMEM = "Block Write Exception";
+const char error_35_str[] PROGMEM = "Invalid Block Number";
+const char error_38_str[] PROGMEM = "Non-existent File";
 const char error_70_str[] PROGMEM = "Buffer if Full";
 
 const exception_t exception[] PROGMEM = {
@@ -116,14 +123,21 @@ const exception_t exception[] PROGMEM = {
   { -6,    error_6_str       },
   { -9,    error_9_str       },
   { -10,   error_10_str      },
+  { -12,   error_12_str      },
   { -13,   error_13_str      },
   { -14,   error_14_str      },
   { -16,   error_16_str      },
   { -18,   error_18_str      },
+  { -19,   error_19_str      },
+  { -21,   error_21_str      },
   { -22,   error_22_str      },
   { -23,   error_23_str      },
   { -31,   error_31_str      },
   { -32,   error_32_str      },
+  { -33,   error_33_str      },
+  { -34,   error_34_str      },
+  { -35,   error_35_str      },
+  { -38,   error_38_str      },
   { -70,   error_70_str      },
   { 0,     0                 }
 };
@@ -31,10 +31,17 @@
 /**    __AVR_ATmega2560__ - Untested                                         **/
 /**    __AVR_ATmega32U4__ - Supported                                        **/
 /**                                                                          **/
+/** YAFFA_HOSTED           - Linux build for testing and benchmarks, see the **/
+/**                          Makefile                                        **/
+/**                                                                          **/
 /** Board                   Architecture  Flash        SRAM        EEPROM    **/
 /** ------                  ------------- ------       ------      -------   **/
 /** Uno                     AVR           32K          2K          1K        **/
 /** Leonardo                AVR           32K          2.5K        1K        **/
+/** Teensy 3, other ARM    ARM           256K+        32K+        (a)       **/
+/**                                                                          **/
+/** (a) Taken from E2END. Without an EEPROM library, remove EN_EEPROM_OPS    **/
+/**     and BLOCK_SET below.                                                 **/
 /**                                                                          **/
 /******************************************************************************/
 #ifndef __YAFFA_H__
@@ -43,8 +50,9 @@
 /******************************************************************************/
 /** Memory Alignment Macros                                                  **/
 /******************************************************************************/
-#define ALIGN_P(x)  x = (cell_t*)((size_t)(x + 1) & -2)
-#define ALIGN(x)  x = ((size_t)(x + 1) & -2)
+#define ALIGN_P(x)  x = (cell_t*)(((size_t)(x) + sizeof(cell_t) - 1) & \
+                              ~(sizeof(cell_t) - 1))
+#define ALIGN(x)  x = (((x) + sizeof(cell_t) - 1) & ~(sizeof(cell_t) - 1))
 
 #define T_SIZE(x) pow( 256, sizeof( x ) ) - 1
 #define MAX_OF(type) \
@@ -58,11 +66,37 @@
 
 /******************************************************************************/
 /** Memory Types                                                             **/
+/**   CELL_BITS - Width of a cell, 16, 32 or 64. A cell must hold an address,**/
+/**               so it defaults to 16 on AVR and 32 on the other boards.    **/
+/**               The hosted build takes it from the Makefile.               **/
 /******************************************************************************/
+#ifndef CELL_BITS
+  #if defined(__AVR__)
+    #define CELL_BITS 16
+  #else
+    #define CELL_BITS 32
+  #endif
+#endif
+
+#if CELL_BITS == 16
 typedef int16_t cell_t;
 typedef uint16_t ucell_t;
 typedef int32_t dcell_t;
 typedef uint32_t udcell_t;
+#elif CELL_BITS == 32
+typedef int32_t cell_t;
+typedef uint32_t ucell_t;
+typedef int64_t dcell_t;
+typedef uint64_t udcell_t;
+#elif CELL_BITS == 64
+typedef int64_t cell_t;
+typedef uint64_t ucell_t;
+typedef __int128 dcell_t;
+typedef unsigned __int128 udcell_t;
+#else
+  #error CELL_BITS must be 16, 32 or 64
+#endif
+#define LOOP_BIAS      ((ucell_t)1 << (CELL_BITS - 1))  // See loopLimit
 
 /******************************************************************************/
 /**  Environmental Constants and Name Strings                                **/
@@ -85,6 +119,12 @@ typedef uint32_t udcell_t;
 /**                 size for an ANS Forth is 80.                             **/
 /**   TOKEN_SIZE  - Size of the token (Word) buffer. Max. length of a        **/
 /**                 Definitions names shall is TOKEN_SIZE - 1 characters.    **/
+/**   RX_SIZE     - Size of the serial input ring buffer, in characters. A   **/
+/**                 power of two, used on top of the 64 byte Serial buffer.  **/
+/**   BLOCK_SIZE  - Size of a BLOCK in characters. EEPROM holds              **/
+/**                 (E2END + 1) / BLOCK_SIZE blocks.                         **/
+/**   BLOCK_BUFFERS - Number of block buffers kept in RAM. BLOCK_SET is off  **/
+/**                 on the Uno and Leonardo, see below.                      **/
 /**   FORTH_SIZE  - Size of Forth Space in bytes                             **/
 /******************************************************************************/
 #if defined(__AVR_ATmega328P__) // Arduino Uno
@@ -97,6 +137,9 @@ typedef uint32_t udcell_t;
   #define STACK_SIZE    16
   #define BUFFER_SIZE   96
   #define WORD_SIZE     32
+  #define RX_SIZE       32
+  #define BLOCK_SIZE    64
+  #define BLOCK_BUFFERS 2
 
 #elif defined(__AVR_ATmega1280__) || defined(__AVR_ATmega2560__)  // Mega 1280 & 2560
   static const unsigned long EPROM_SIZE = 4;
@@ -108,6 +151,9 @@ typedef uint32_t udcell_t;
   #define STACK_SIZE    32
   #define BUFFER_SIZE   127
   #define WORD_SIZE     32
+  #define RX_SIZE       128
+  #define BLOCK_SIZE    256
+  #define BLOCK_BUFFERS 4
 
 #elif defined(__AVR_ATmega32U4__) // Arduino Leonardo
   static const unsigned long EPROM_SIZE = 1;
@@ -119,6 +165,40 @@ typedef uint32_t udcell_t;
   #define STACK_SIZE    16
   #define BUFFER_SIZE   96
   #define WORD_SIZE     32
+  #define RX_SIZE       32
+  #define BLOCK_SIZE    64
+  #define BLOCK_BUFFERS 2
+
+#elif defined(__arm__) // 32 bit ARM boards
+  static const unsigned long EPROM_SIZE = 1;
+  static const unsigned long SRAM_SIZE = 32;
+  #define PROC_STR "ARM"
+  #define HOLD_SIZE     (2 * CELL_BITS + 3)
+  #define PAD_SIZE      127
+  #define RSTACK_SIZE   64
+  #define STACK_SIZE    64
+  #define BUFFER_SIZE   127
+  #define WORD_SIZE     32
+  #define RX_SIZE       128
+  #define BLOCK_SIZE    128
+  #define BLOCK_BUFFERS 4
+  #ifndef E2END
+    #define E2END       0x3FF
+  #endif
+
+#elif defined(YAFFA_HOSTED) // Linux, see the Makefile
+  static const unsigned long EPROM_SIZE = 1;
+  static const unsigned long SRAM_SIZE = 1024;
+  #define PROC_STR "Hosted"
+  #define HOLD_SIZE     (2 * CELL_BITS + 3)
+  #define PAD_SIZE      127
+  #define RSTACK_SIZE   32
+  #define STACK_SIZE    32
+  #define BUFFER_SIZE   127
+  #define WORD_SIZE     32
+  #define RX_SIZE       64
+  #define BLOCK_SIZE    128
+  #define BLOCK_BUFFERS 4
 
 #endif
 
@@ -130,6 +210,9 @@ static const unsigned long FORTH_SIZE    ((SRAM_SIZE*1024*2)/(sizeof(cell_t)*3))
 /**                       Enable Dictionary Word Sets                         **/
 /*******************************************************************************/
 #define CORE_EXT_SET
+#if !defined(__AVR_ATmega328P__) && !defined(__AVR_ATmega32U4__)
+#define BLOCK_SET          // Buffers and wear counts take too much of 2K SRAM
+#endif
 #define DOUBLE_SET
 #define EXCEPTION_SET
 #define LOCALS_SET
@@ -141,6 +224,60 @@ static const unsigned long FORTH_SIZE    ((SRAM_SIZE*1024*2)/(sizeof(cell_t)*3))
 #define EN_ARDUINO_OPS
 #define EN_EEPROM_OPS
 
+/*******************************************************************************/
+/**                          Inner Interpreter                                **/
+/**  EN_FAST_INNER - executeWord() keeps ip in a local and dispatches the     **/
+/**                  primitives at the start of flashDict[] through a         **/
+/**                  computed goto table. Remove to use the plain loop that   **/
+/**                  calls every primitive through flashDict[].               **/
+/*******************************************************************************/
+#define EN_FAST_INNER
+
+/*******************************************************************************/
+/**                          Serial Input                                     **/
+/**  SERIAL_BAUD - Speed of the serial port.                                  **/
+/**  EN_XON_XOFF - Send XOFF before a line runs while more input is pending,  **/
+/**                or when the input buffers are nearly full, and XON once    **/
+/**                they have drained, so a terminal sending a file waits      **/
+/**                while lines compile. Set the terminal to XON/XOFF          **/
+/**                (software) flow control. The hosted build reads a pipe     **/
+/**                and needs none.                                            **/
+/**  RTS_PIN     - Also drive this pin high to stop the sender and low to let **/
+/**                it go on, for an adapter with hardware flow control.       **/
+/*******************************************************************************/
+#define SERIAL_BAUD 115200
+#ifndef YAFFA_HOSTED
+#define EN_XON_XOFF
+#endif
+//#define RTS_PIN 2
+
+/*******************************************************************************/
+/**  INLINE_SIZE - Colon definitions with a body of at most this many cells   **/
+/**                are copied into their callers instead of being called.     **/
+/**                The default for INLINE-LIMIT; 0 disables inlining.         **/
+/*******************************************************************************/
+#define INLINE_SIZE 4
+
+/*******************************************************************************/
+/**  EN_BENCH_STATS - Count dispatches and parsed tokens and record the peak  **/
+/**                   stack and Forth Space use for ".STATS". Costs a counter **/
+/**                   increment per dispatch. The hosted build turns it on.   **/
+/*******************************************************************************/
+//#define EN_BENCH_STATS
+
+/*******************************************************************************/
+/**  EN_PROFILE    - Per word profiler for ".PROFILE". While PROFILE-ON is in **/
+/**                  effect executeWord() hands over to profileWord(), so it  **/
+/**                  costs nothing per dispatch while off. The hosted build   **/
+/**                  turns it on.                                             **/
+/**  PROFILE_SIZE  - Words the profiler keeps apart, a power of two. Words    **/
+/**                  past that are counted together as "other".               **/
+/**  PROFILE_TOP   - Rows in each list printed by ".PROFILE".                 **/
+/*******************************************************************************/
+//#define EN_PROFILE
+#define PROFILE_SIZE 16
+#define PROFILE_TOP  8
+
 /******************************************************************************/
 /**  Numbering system                                                        **/
 /******************************************************************************/
@@ -155,6 +292,8 @@ static const unsigned long FORTH_SIZE    ((SRAM_SIZE*1024*2)/(sizeof(cell_t)*3))
 #define ASCII_BS    8
 #define ASCII_TAB   9
 #define ASCII_NL    10
+#define ASCII_XON   17
+#define ASCII_XOFF  19
 #define ASCII_ESC   27
 #define ASCII_CR    13
 
@@ -176,6 +315,8 @@ static const unsigned long FORTH_SIZE    ((SRAM_SIZE*1024*2)/(sizeof(cell_t)*3))
 /******************************************************************************/
 // 
 #define NORMAL         0x00
+#define PRIVATE        0x08    // Header is in the name region, see PRIVATE
+#define INLINE         0x10    // Word is always compiled inline, see INLINE
 #define SMUDGE         0x20    // Word is hidden during searches
 #define COMP_ONLY      0x40    // Word is only usable during compilation
 #define IMMEDIATE      0x80    // Word is executed during compilation state
@@ -188,21 +329,106 @@ static const unsigned long FORTH_SIZE    ((SRAM_SIZE*1024*2)/(sizeof(cell_t)*3))
 #define DO_SYS       -2
 #define CASE_SYS     -3
 #define OF_SYS       -4
-#define LOOP_SYS     -5
+#define FOR_SYS      -5
 #define LEAVE_SYS    -6
 
 
 /******************************************************************************/
 /**  User Dictionary Header                                                  **/
+/**    Links are counts of cells back from the entry, 0 for none, so a       **/
+/**    header is the same size for any cell width and needs no rebasing.     **/
+/**    The code field follows the name at the next cell boundary. PRIVATE    **/
+/**    headers sit in the name region at the top of Forth Space instead,     **/
+/**    where prevEntry counts up to the previous private header and the name **/
+/**    is followed by a cell holding the code field address. See entryCfa(). **/
 /******************************************************************************/
+typedef uint16_t link_t;
+#define LINK_MAX       0xFFFF
+
 typedef struct  {            // structure of the user dictionary
-  void*        prevEntry;    // Pointer to the previous entry
-  cell_t*      cfa;          // Code Field Address
-  uint8_t      flags;        // Holds the length of the following name 
-                             // and any flags.
-  char         name[];       // Variable length name
+  link_t       prevEntry;    // Cells back to the previous entry
+  link_t       prevInBucket; // Cells back to the previous entry in the same
+                             // hash bucket
+  uint8_t      flags;        // IMMEDIATE, INLINE, PRIVATE ...
+  char         name[];       // Null terminated name
 } userEntry_t;
 
+/******************************************************************************/
+/**  CREATEd Words                                                           **/
+/**    CREATE compiles "literal <data field> exit exit". DOES> replaces the  **/
+/**    first exit with the address of its code. The data field follows the  **/
+/**    second exit, CREATE_BODY cells from the XT.                           **/
+/******************************************************************************/
+#define CREATE_BODY    4
+
+/******************************************************************************/
+/**  Dictionary Image Header                                                 **/
+/**    SAVE-IMAGE writes forthSpace up to HERE to the top of EEPROM and      **/
+/**    this header to its last bytes, above any source stored by eeLoad from **/
+/**    address 0. Pointers are kept as byte offsets from forthSpace. The     **/
+/**    checksum covers the image and the header up to its own field.         **/
+/******************************************************************************/
+#define IMAGE_MAGIC    0x59F1  // 0xF1 'Y', which erased EEPROM never holds
+#define IMAGE_NONE     0xFFFF  // Offset of a NULL pointer
+
+typedef struct {
+  size_t       origin;       // Address of forthSpace when it was saved
+  uint16_t     version;      // flashVersion() of the saving firmware
+  uint16_t     size;         // Bytes of forthSpace below the header
+  uint16_t     last;         // Offset of pLastUserEntry
+  uint16_t     base;         // Number conversion radix
+  uint16_t     checksum;     // Fletcher-16 of the image and the fields above
+  uint16_t     magic;        // IMAGE_MAGIC
+} imageHeader_t;
+
+/******************************************************************************/
+/**  Block Buffer                                                            **/
+/**    Block u is the BLOCK_SIZE characters of EEPROM from                   **/
+/**    (u - 1) * BLOCK_SIZE. LIST shows it as lines of BLOCK_LINE            **/
+/**    characters; LOAD interprets it as a single line.                      **/
+/******************************************************************************/
+#define BLOCK_COUNT    ((E2END + 1) / BLOCK_SIZE)
+#define BLOCK_LINE     32
+
+typedef struct {
+  cell_t       blk;          // Block assigned to the buffer, 0 if none
+  uint16_t     used;         // blockClock when last used, for LRU
+  bool         dirty;        // Changed since it was read, see UPDATE
+  char         data[BLOCK_SIZE];
+} blockBuffer_t;
+
+/******************************************************************************/
+/**  Profiler Entry                                                          **/
+/******************************************************************************/
+typedef struct {
+  cell_t         xt;           // Word counted here, 0 if the slot is free
+  unsigned long  calls;        // Times it was executed
+  unsigned long  time;         // Self time in microseconds
+} profile_t;
+
+/******************************************************************************/
+/**  Task Control Block                                                      **/
+/**    Made in forthSpace by TASK. While a task runs its stacks, ip and      **/
+/**    stack indexes are in the globals, and its task_t holds those of the   **/
+/**    operator (the outer interpreter) instead. swapTask() trades them.     **/
+/******************************************************************************/
+#define TASK_STOPPED   0
+#define TASK_RUNNING   1
+
+typedef struct {
+  void*          next;         // Next started task in the round
+  cell_t*        ip;
+  unsigned long  wake;         // millis() the task sleeps until, see MS
+  int8_t         tos;
+  int8_t         rtos;
+  ucell_t        loopIndex;    // The loop frame, see loopLimit
+  ucell_t        loopLimit;
+  uint8_t        state;        // Compile state, always FALSE for a task
+  uint8_t        status;       // TASK_STOPPED or TASK_RUNNING, never swapped
+  cell_t         stack[STACK_SIZE];
+  cell_t         rStack[RSTACK_SIZE];
+} task_t;
+
 /******************************************************************************/
 /**  Flash Dictionary Structure                                              **/
 /******************************************************************************/
@@ -212,10 +438,38 @@ typedef struct  {                   // Structure of the dictionary
   const char*    name;              // Pointer the Word Name in flash
   const func     function;          // Pointer to function
   const uint8_t  flags;             // Holds word type flags
+  const uint8_t  effect;            // Declared stack effect, see EFFECT()
 } flashEntry_t;
 
+/******************************************************************************/
+/**  Primitive Stack Effects                                                 **/
+/**    EFFECT(in, out) declares that a primitive takes in cells from the     **/
+/**    data stack and leaves out cells. executePrimitive() checks it once    **/
+/**    before the call, so the primitive can use the unchecked TOP/NOS       **/
+/**    access in YAFFA.ino. NO_EFFECT means the primitive checks the stack   **/
+/**    itself with push() and pop().                                         **/
+/******************************************************************************/
+#define NO_EFFECT       0
+#define EFFECT(in, out) (((in) << 4) | (out))
+#define EFFECT_IN(e)    ((e) >> 4)
+#define EFFECT_OUT(e)   ((e) & 0x0F)
+
 extern const PROGMEM flashEntry_t flashDict[];        // forward reference
 
+/******************************************************************************/
+/**  Dictionary Hash                                                         **/
+/**    Both dictionaries are searched through hash buckets. The hash ignores **/
+/**    case (c | 0x20) so one value serves the case sensitive user search    **/
+/**    and the case insensitive flash search.                                **/
+/**    FLASH_BUCKETS - Number of buckets for the flash dictionary, stored in **/
+/**                    flash. Must be a power of two.                        **/
+/**    USER_BUCKETS  - Number of buckets for the user dictionary, stored in  **/
+/**                    RAM. Must be a power of two.                          **/
+/******************************************************************************/
+#define FLASH_BUCKETS  64
+#define USER_BUCKETS   8
+#define HASH_STEP(h, c) ((uint8_t)(((h) << 5) + (h)) ^ ((uint8_t)(c) | 0x20))
+
 /******************************************************************************/
 /**  Flash Dictionary Index References                                       **/
 /**  This words referenced here must match the order in the beginning of the **/
@@ -239,5 +493,39 @@ extern const PROGMEM flashEntry_t flashDict[];        // forward reference
 #define OVER_IDX           16
 #define EQUAL_IDX          17
 #define DROP_IDX           18
+#define PLUS_IDX           19
+#define FETCH_IDX          20
+#define STORE_IDX          21
+#define DUP_IDX            22
+#define R_FETCH_IDX        23
 
-#endif
+/******************************************************************************/
+/**  Fused Primitive Index References                                        **/
+/**  Superinstructions compileWord() substitutes for common sequences. They  **/
+/**  follow the fixed block and are hidden (SMUDGE) from searches.           **/
+/******************************************************************************/
+#define LIT_PLUS_IDX       24    // literal +
+#define FETCH_PLUS_IDX     25    // @ +
+#define R_FETCH_FETCH_IDX  26    // r@ @
+#define DUP_ZJUMP_IDX      27    // dup zjump
+#define LIT_EQ_ZJUMP_IDX   28    // literal = zjump
+#define OVER_EQ_ZJUMP_IDX  29    // over = zjump
+#define LIT_OF_IDX         30    // literal over = zjump
+
+/******************************************************************************/
+/**  Hidden Run-Time Index References                                        **/
+/******************************************************************************/
+#define FORGET_SYS_IDX     31    // Body of a MARKER
+
+/******************************************************************************/
+/**  Loop Run-Time Index References                                          **/
+/**  ?DO, FOR and NEXT, and I and J so the fast machine can dispatch them.   **/
+/**  J_IDX is the last index in its dispatch table.                          **/
+/******************************************************************************/
+#define QDO_SYS_IDX        32
+#define FOR_SYS_IDX        33
+#define NEXT_SYS_IDX       34
+#define I_IDX              35
+#define J_IDX              36
+
+#endif
@@ -40,6 +40,45 @@
 /**                                                                          **/
 /**    0.7.0                                                                **/
 /**    - Fixed the how LEAVE is handled in LOOP and +LOOP.                   **/
+/**    - Dictionary searches go through hash buckets. The flash table is     **/
+/**      built at compile time and kept in flash.                            **/
+/**    - Added EN_FAST_INNER, a computed goto executeWord() for the hot      **/
+/**      primitives. "+", "@" and "!" moved into the fixed index block.      **/
+/**    - Primitives declare their stack effect in flashDict[], which is      **/
+/**      checked once by executePrimitive(). The fast executeWord() caches   **/
+/**      the top of stack in a local.                                        **/
+/**    - Added a peephole pass to the colon compiler that fuses common       **/
+/**      sequences such as "1 +", "dup if" and OF into one primitive.        **/
+/**    - Short colon definitions are compiled inline. Added "INLINE" and     **/
+/**      "INLINE-LIMIT".                                                     **/
+/**    - Added a hosted Linux build (Makefile, host/) and the benchmarks in  **/
+/**      bench/. EN_BENCH_STATS adds ".STATS".                               **/
+/**    - Added "SAVE-IMAGE" and "LOAD-IMAGE". setup() loads the dictionary   **/
+/**      image from EEPROM before falling back to the stored source.         **/
+/**    - Added EN_PROFILE, a per word profiler with "PROFILE-ON",            **/
+/**      "PROFILE-OFF", "PROFILE-RESET" and ".PROFILE".                      **/
+/**    - Added cooperative tasks: "TASK", "START", "PAUSE" and "STOP". "MS"  **/
+/**      and "DELAY" let the other tasks run. Added "MILLIS" and "MICROS".   **/
+/**    - Serial input goes through a ring buffer that is filled between      **/
+/**      tokens, with XON/XOFF (EN_XON_XOFF) or RTS_PIN flow control, so     **/
+/**      files can be sent at 115200 baud. "eeLoad" uses it too.             **/
+/**    - Added the BLOCK word set over EEPROM with BLOCK_BUFFERS buffers in  **/
+/**      RAM. Every EEPROM write goes through eeUpdate(), which skips bytes  **/
+/**      that do not change, and is counted for "eeWear".                    **/
+/**    - The cell width is set by CELL_BITS: 16 on AVR, 32 on ARM, and 32    **/
+/**      or 64 on the hosted build. Alignment follows the cell size. Fixed   **/
+/**      the CREATE data field, DOES>, WORD counts, ALLOT, M* and UM/MOD.    **/
+/**    - User headers use 16 bit relative links and no code field pointer.   **/
+/**      Added "MARKER", "FORGET", and "PRIVATE", "PUBLIC" and "SEAL" for    **/
+/**      headers that are dropped once the words using them are compiled.    **/
+/**    - DO loops keep their index and limit in a loop frame instead of      **/
+/**      three return stack cells, and are checked only at compile time.     **/
+/**      Added "?DO", "UNLOOP", "FOR" and "NEXT".                            **/
+/**    - Tokens are parsed in place in the input buffer and names compared   **/
+/**      by length first. Numbers are converted through a digit table, and   **/
+/**      strings compiled by S" and ." are no longer cut at the token size.  **/
+/**      ">NUMBER" follows the standard and "1." style double literals are   **/
+/**      accepted.                                                           **/
 /**    0.6.2                                                                 **/
 /**    - Added words ">NUMBER", "KEY?", ".(", "0<>", "0>", "2>R", "2R>",     **/
 /**      "2R@".                                                              **/
@@ -72,13 +111,9 @@
 /**                                                                          **/
 /**  THINGS TO DO:                                                           **/
 /**                                                                          **/
-/**  CORE WORDS TO ADD:                                                      **/
-/**      >NUMBER                                                             **/
-/**                                                                          **/
 /**  THINGS TO FIX:                                                          **/
 /**                                                                          **/
 /**    Fix the outer interpreter to use FIND instead of isWord               **/
-/**    Fix Serial.Print(w, HEX) from displaying negative numbers as 32 bits  **/
 /**    Fix ENVIRONMENT? Query to take a string reference from the stack.     **/
 /**                                                                          **/
 /******************************************************************************/
@@ -89,6 +124,10 @@
 #include <EEPROM.h>
 #include <avr/pgmspace.h>
 
+#ifndef pgm_read_ptr            // Older avr-libc, where pointers are 16 bits
+#define pgm_read_ptr(addr) ((void*)pgm_read_word(addr))
+#endif
+
 /******************************************************************************/
 /** Major and minor revision numbers                                         **/
 /******************************************************************************/
@@ -114,6 +153,31 @@ const char octal_str[] PROGMEM = "0";
 const char binary_str[] PROGMEM = "%";
 const char zero_str[] PROGMEM = "0";
 
+/******************************************************************************/
+/** Value of each character as a digit, either case, or XX if it is none.    **/
+/** A character is a digit in a radix when its value is less than it.        **/
+/******************************************************************************/
+#define XX 0xFF
+const uint8_t digitValue[256] PROGMEM = {
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+   0,  1,  2,  3,  4,  5,  6,  7,  8,  9, XX, XX, XX, XX, XX, XX,
+  XX, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+  25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, XX, XX, XX, XX, XX,
+  XX, 10, 11, 12, 13, 14, 15, 16, 17, 18, 19, 20, 21, 22, 23, 24,
+  25, 26, 27, 28, 29, 30, 31, 32, 33, 34, 35, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX,
+  XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX, XX
+};
+#undef XX
+
 /******************************************************************************/
 /** Global Variables                                                         **/
 /******************************************************************************/
@@ -129,6 +193,12 @@ char* cpToIn;                   // Points to a position in the source string
 char cDelimiter = ' ';          // The parsers delimiter
 char cInputBuffer[BUFFER_SIZE]; // Input Buffer that gets parsed
 char cTokenBuffer[WORD_SIZE];  // Stores Single Parsed token to be acted on
+char* cpToken = cTokenBuffer;   // The last token parsed, in the source string
+uint8_t tokenLength = 0;        // and its length. See parseToken()
+char cRxRing[RX_SIZE];          // Serial input not read yet, see serialPoll()
+uint8_t rxHead = 0;             // Next character to read from cRxRing
+uint8_t rxTail = 0;             // Next free place in cRxRing
+bool rxStopped = false;         // The sender was told to stop
 
 /******************************************************************************/
 /**  Stacks and Associated Registers                                         **/
@@ -143,6 +213,17 @@ int8_t rtos = -1;                       // The return stack index
 cell_t stack[STACK_SIZE];               // The data stack
 cell_t rStack[RSTACK_SIZE];             // The return stack
 
+/******************************************************************************/
+/**  Loop Frame                                                              **/
+/**  The index and limit of the innermost DO, ?DO or FOR loop. Entering a    **/
+/**  loop saves the frame of the enclosing one on the return stack, so J is  **/
+/**  the two cells on top of it. The limit is kept as limit + LOOP_BIAS and  **/
+/**  the index relative to that, so I is their sum and the loop ends when    **/
+/**  stepping the index overflows, whichever way +LOOP counts.               **/
+/******************************************************************************/
+ucell_t loopIndex;
+ucell_t loopLimit;
+
 /******************************************************************************/
 /**  Flash Dictionary Structure                                              **/
 /******************************************************************************/
@@ -154,6 +235,10 @@ const flashEntry_t* pFlashEntry = flashDict;   // Pointer into the flash Diction
 userEntry_t* pLastUserEntry = NULL;
 userEntry_t* pUserEntry = NULL;
 userEntry_t* pNewUserEntry = NULL;
+userEntry_t* pLatest = NULL;     // Last entry closed, for IMMEDIATE and INLINE
+userEntry_t* userBucket[USER_BUCKETS];  // Newest entry in each hash bucket
+userEntry_t* pLastPrivate = NULL;       // Newest header in the name region
+bool privateHeaders = false;     // Set by PRIVATE, cleared by PUBLIC
 
 /******************************************************************************/
 /**  Flags - Internal State and Word                                         **/
@@ -166,16 +251,74 @@ uint8_t wordFlags;             // Word flags
 /******************************************************************************/
 int8_t errorCode = 0;
 
+/******************************************************************************/
+/** Benchmark Statistics, see EN_BENCH_STATS and ".STATS"                    **/
+/******************************************************************************/
+#ifdef EN_BENCH_STATS
+#define STAT(x) x
+#define STAT_PAINT 0x5A5A        // Fills stack cells that were never used
+unsigned long statDispatches;    // XTs fetched by executeWord()
+unsigned long statTokens;        // Tokens parsed by interpreter()
+cell_t* pStatPeakHere;           // Highest HERE at the end of a definition
+#else
+#define STAT(x)
+#endif
+
+/******************************************************************************/
+/** Profiler, see EN_PROFILE and ".PROFILE"                                  **/
+/******************************************************************************/
+#ifdef EN_PROFILE
+bool profiling = false;          // Set by PROFILE-ON
+profile_t profile[PROFILE_SIZE]; // Open addressed on the XT
+profile_t profileOther;          // Words that found no free slot
+cell_t profileOwner;             // XT that the time since profileLast is for
+unsigned long profileLast;
+cell_t profileDef;               // Definition whose body is running
+cell_t profileCaller[RSTACK_SIZE];
+uint8_t profileDepth;
+#endif
+
+/******************************************************************************/
+/** Tasks, see TASK and PAUSE                                                **/
+/******************************************************************************/
+task_t* pTaskList = NULL;        // Started tasks, newest first
+task_t* pTask = NULL;            // Task that is running, NULL for the operator
+cell_t* pTaskResume;             // Where PAUSE left the running task
+
+/******************************************************************************/
+/** EEPROM Writes, see eeUpdate() and eeWear                                 **/
+/******************************************************************************/
+unsigned long eeWrites = 0;      // Bytes written since the last eeWear
+unsigned long eeSkips = 0;       // Bytes that already held the value
+#ifdef BLOCK_SET
+uint16_t eeWearMap[BLOCK_COUNT]; // Bytes written to each block since reset
+#endif
+
+/******************************************************************************/
+/** Block Buffers, see BLOCK                                                 **/
+/******************************************************************************/
+#ifdef BLOCK_SET
+blockBuffer_t blockBuffers[BLOCK_BUFFERS];
+blockBuffer_t* pBlock = NULL;    // Buffer of the last BLOCK or BUFFER
+uint16_t blockClock = 0;         // Counts buffer uses
+cell_t blk = 0;                  // BLK, block being LOADed or 0
+cell_t scr = 0;                  // SCR, block last LISTed
+#endif
+
 /******************************************************************************/
 /**  Forth Space (Name, Code and Data Space) and Associated Registers        **/
 /******************************************************************************/
 char* pPNO;                  // Pictured Numeric Output Pointer
 cell_t forthSpace[FORTH_SIZE]; // Reserve a block on RAM for the forth environment
+char* pNames = (char*)&forthSpace[FORTH_SIZE]; // Bottom of the name region,
+                             // which grows down from the end of Forth Space
 cell_t* pHere;               // HERE, points to the next free position in
                              // Forth Space
 cell_t* pOldHere;            // Used by "colon-sys"
 cell_t* pCodeStart;          // used by "colon-sys" and RECURSE
 cell_t* pDoes;               // Used by CREATE and DOES>
+cell_t* pLastOp;             // Last instruction compiled, see compileWord()
+cell_t* pPrevOp;             // Instruction compiled before pLastOp
 
 /******************************************************************************/
 /** Forth Global Variables                                                   **/
@@ -196,13 +339,21 @@ uint8_t serial_print_P(PGM_P ptr);
 void setup(void) {                
   uint16_t mem;
   uint8_t e1,e2;
-  Serial.begin(19200);     // Open serial communications:
+  Serial.begin(SERIAL_BAUD);  // Open serial communications:
+#ifdef RTS_PIN
+  pinMode(RTS_PIN, OUTPUT);
+  digitalWrite(RTS_PIN, LOW);   // Clear to send
+#endif
 
   flags = ECHO_ON;
   base = DECIMAL;
 
   pHere = &forthSpace[0];
   pOldHere = pHere;
+#ifdef EN_BENCH_STATS
+  for (uint8_t i = 0; i < STACK_SIZE; i++) stack[i] = STAT_PAINT;
+  for (uint8_t i = 0; i < RSTACK_SIZE; i++) rStack[i] = STAT_PAINT;
+#endif
   
   Serial.print(F("\n YAFFA - Yet Another Forth For Arduino, "));
   Serial.print(F("Version "));
@@ -219,7 +370,7 @@ void setup(void) {
   Serial.print(F(" Pre-Defined Words : "));
   pFlashEntry = flashDict;
   w = 0;
-  while(pgm_read_word(&(pFlashEntry->name))) {
+  while(pgm_read_ptr(&(pFlashEntry->name))) {
     w++;
     pFlashEntry++;
   }
@@ -238,6 +389,9 @@ void setup(void) {
   Serial.print(F(" Address Size: \t\t\t"));
   Serial.print(sizeof(void*) * 8);
   Serial.println(F(" Bits"));
+  Serial.print(F(" Cell Size: \t\t\t"));
+  Serial.print(sizeof(cell_t) * 8);
+  Serial.println(F(" Bits"));
   Serial.print(F(" Core Word set: \t\t"));
   Serial.println(CORE ? F("TRUE") : F("FALSE"));
   Serial.print(F(" Ext. Core Word set: \t\t"));
@@ -268,23 +422,23 @@ void setup(void) {
   Serial.print(F("\r\n Input Buffer: Size "));
   Serial.print(BUFFER_SIZE);
   Serial.print(F(" Bytes, Starts at $"));
-  Serial.print((int)&cInputBuffer[0], HEX);
+  Serial.print((size_t)&cInputBuffer[0], HEX);
   Serial.print(F(", Ends at $"));
-  Serial.println((int)&cInputBuffer[BUFFER_SIZE] - 1, HEX);
+  Serial.println((size_t)&cInputBuffer[BUFFER_SIZE] - 1, HEX);
 
   Serial.print(F(" Token Buffer: Size "));
   Serial.print(WORD_SIZE);
   Serial.print(F(" Bytes, Starts at $"));
-  Serial.print((int)&cTokenBuffer[0], HEX);
+  Serial.print((size_t)&cTokenBuffer[0], HEX);
   Serial.print(F(", Ends at $"));
-  Serial.println((int)&cTokenBuffer[WORD_SIZE] - 1, HEX);
+  Serial.println((size_t)&cTokenBuffer[WORD_SIZE] - 1, HEX);
 
   Serial.print(F(" Forth Space: Size "));
   Serial.print(FORTH_SIZE);
   Serial.print(F(" Cells, Starts at $"));
-  Serial.print((int)&forthSpace[0], HEX);
+  Serial.print((size_t)&forthSpace[0], HEX);
   Serial.print(F(", Ends at $"));
-  Serial.println((int)&forthSpace[FORTH_SIZE] - 1, HEX);
+  Serial.println((size_t)&forthSpace[FORTH_SIZE] - 1, HEX);
 
   mem = freeMemory();
   Serial.print(F(" C Heap: "));
@@ -304,14 +458,24 @@ void setup(void) {
   Serial.println();
   pinMode(14,0);
 
-  if( (e1 == 0xff) && (e2 == 0xff )) {
-    serial_print_P(PSTR(" EEPROM Empty\r\n"));
+  // The image sits at the top of EEPROM and the source at the bottom, so
+  // the source is still there when the image is missing or invalid.
+  if( digitalRead(14) == 0) {
+    serial_print_P(PSTR(" Load from EEPROM inhibited by pin 14.\r\n"));
   } else {
-    serial_print_P(PSTR(" Load from EEPROM.\r\n"));
-    if( digitalRead(14) == 0) {
-        serial_print_P(PSTR(" Inhibited by pin 14.\r\n"));
+    cell_t error = loadImage();
+    if (error == 0) {
+      serial_print_P(PSTR(" Dictionary image loaded.\r\n"));
     } else {
+      if (error != -38) {
+        serial_print_P(PSTR(" Dictionary image is invalid.\r\n"));
+      }
+      if( (e1 == 0xff) && (e2 == 0xff )) {
+        if (error == -38) serial_print_P(PSTR(" EEPROM Empty\r\n"));
+      } else {
+        serial_print_P(PSTR(" Load from EEPROM.\r\n"));
         _eeInterpret();
+      }
     }
   }
   // <<< Contributed by Andrew Holt
@@ -326,6 +490,7 @@ void loop(void) {
   cpSource = cpToIn = cInputBuffer;
   cpSourceEnd = cpSource + getLine(cpSource, BUFFER_SIZE);
   if (cpSourceEnd > cpSource) {
+    if (!rxStopped && serialAvailable()) rxFlow(true);  // See serialPoll()
     interpreter();
     if (errorCode) {
         errorCode = 0;
@@ -348,6 +513,74 @@ void loop(void) {
   }
 }
 
+/******************************************************************************/
+/** Serial Input                                                             **/
+/**   serialPoll() moves what the Serial buffer holds into cRxRing. It is    **/
+/**   called between tokens, in PAUSE and MS and while waiting for input, so **/
+/**   the next lines of a file keep arriving while one is compiled. A single **/
+/**   token may run for long without a poll, so with EN_XON_XOFF or RTS_PIN  **/
+/**   loop() stops the sender before it runs a line while more input is     **/
+/**   pending, which leaves the Serial buffer free to take what is already   **/
+/**   on its way. The sender is also stopped when the ring and the Serial    **/
+/**   buffer together are nearly full, and started again once they hold no  **/
+/**   more than half of the ring.                                            **/
+/******************************************************************************/
+#define RX_COUNT()  ((uint8_t)(rxTail - rxHead) & (RX_SIZE - 1))
+#define RX_PENDING() (RX_COUNT() + Serial.available())
+
+void rxFlow(bool stop) {
+  rxStopped = stop;
+#ifdef EN_XON_XOFF
+  Serial.write(stop ? ASCII_XOFF : ASCII_XON);
+#endif
+#ifdef RTS_PIN
+  digitalWrite(RTS_PIN, stop ? HIGH : LOW);
+#endif
+}
+
+void serialPoll(void) {
+  while (RX_COUNT() < RX_SIZE - 1 && Serial.available()) {
+    cRxRing[rxTail] = Serial.read();
+    rxTail = (rxTail + 1) & (RX_SIZE - 1);
+  }
+  if (!rxStopped && RX_PENDING() >= RX_SIZE - RX_SIZE / 4) rxFlow(true);
+}
+
+bool serialAvailable(void) {
+  serialPoll();
+  return rxHead != rxTail;
+}
+
+/******************************************************************************/
+/** Next character from the ring buffer. The caller checks serialAvailable() **/
+/******************************************************************************/
+char serialRead(void) {
+  char c = cRxRing[rxHead];
+  rxHead = (rxHead + 1) & (RX_SIZE - 1);
+  if (rxStopped && RX_PENDING() <= RX_SIZE / 2) rxFlow(false);
+  return c;
+}
+
+/******************************************************************************/
+/** EEPROM Writes                                                            **/
+/**   eeUpdate() is the one place that writes EEPROM. It only writes a byte  **/
+/**   that differs from the value wanted, since each write costs about 3.3   **/
+/**   ms and some of the cell's life, and counts the writes for eeWear.      **/
+/**   Returns false if the byte does not read back.                          **/
+/******************************************************************************/
+bool eeUpdate(uint16_t addr, uint8_t value) {
+  if (EEPROM.read(addr) == value) {
+    eeSkips++;
+    return true;
+  }
+  EEPROM.write(addr, value);
+  eeWrites++;
+#ifdef BLOCK_SET
+  if (addr / BLOCK_SIZE < BLOCK_COUNT) eeWearMap[addr / BLOCK_SIZE]++;
+#endif
+  return EEPROM.read(addr) == value;
+}
+
 /******************************************************************************/
 /** getKey                                                                   **/
 /**   waits for the next valid key to be entered and return its value        **/
@@ -358,12 +591,15 @@ char getKey(void) {
   char inChar;
 
   while (1) {
-    if (Serial.available()) {
-      inChar = Serial.read();
+    if (serialAvailable()) {
+      inChar = serialRead();
       if (inChar == ASCII_BS || inChar == ASCII_TAB || inChar == ASCII_CR || 
           inChar == ASCII_ESC || isprint(inChar)) {
         return inChar; 
       }
+    } else {
+      yield();
+      runTasks();            // Let the tasks run while we wait
     }
   }
 }
@@ -402,9 +638,10 @@ uint8_t getLine(char* ptr, uint8_t buffSize) {
 
 /******************************************************************************/
 /** GetToken                                                                 **/
-/**   Find the next token in the buffer and stores it into the token buffer  **/
-/**   with a NULL terminator. Returns length of the token or 0 if at end off **/
-/**   the buffer.                                                            **/
+/**   parseToken() finds the next token in the buffer and leaves it where it **/
+/**   is, in cpToken and tokenLength. getToken() also copies it into the     **/
+/**   token buffer with a NULL terminator, for the words that parse a name.  **/
+/**   Both return the length of the token or 0 if at end off the buffer.     **/
 /**   Could this become the word WORD?                                       **/
 // ( char "<chars>ccc<chars>" -- c-addr )
 // Skip leading delimiters. Parse characters ccc delimited by char. An ambiguous
@@ -421,23 +658,25 @@ uint8_t getLine(char* ptr, uint8_t buffSize) {
 // included as a concession to existing programs that use CONVERT. A program shall 
 // not depend on the existence of the space.
 /******************************************************************************/
-uint8_t getToken(void) {
-  uint8_t tokenIdx = 0;
-  while (cpToIn <= cpSourceEnd) {
-    if ((*cpToIn == cDelimiter) || (*cpToIn == 0)) {
-      cTokenBuffer[tokenIdx] = '\0';       // Terminate SubString
-      cpToIn++;
-      if (tokenIdx) return tokenIdx;
-    } else {
-      if (tokenIdx < (WORD_SIZE - 1)) {
-        cTokenBuffer[tokenIdx++] = *cpToIn++;
-      }
-    }
+uint8_t parseToken(void) {
+  while (cpToIn <= cpSourceEnd && (*cpToIn == cDelimiter || *cpToIn == 0)) {
+    cpToIn++;
+  }
+  cpToken = cpToIn;
+  while (cpToIn <= cpSourceEnd && *cpToIn != cDelimiter && *cpToIn != 0) {
+    cpToIn++;
   }
-  // If we get to SourceEnd without a delimiter and the token buffer has
-  // something in it return that. Else return 0 to show we found nothing
-  if (tokenIdx) return tokenIdx;
-  else return 0;
+  tokenLength = (cpToIn - cpToken > 255) ? 255 : cpToIn - cpToken;
+  if (cpToIn <= cpSourceEnd) cpToIn++;     // Step over the delimiter
+  return tokenLength;
+}
+
+uint8_t getToken(void) {
+  uint8_t length = parseToken();
+  if (length > WORD_SIZE - 1) length = WORD_SIZE - 1;
+  memcpy(cTokenBuffer, cpToken, length);
+  cTokenBuffer[length] = '\0';
+  return length;
 }
 
 /******************************************************************************/
@@ -448,29 +687,36 @@ uint8_t getToken(void) {
 /** signal an error.                                                         **/
 /******************************************************************************/
 void interpreter(void) {
-  func function;
+  uint8_t cells;
 
-  while (getToken()) {
+  while (parseToken()) {
+    STAT(statTokens++);
+    serialPoll();          // Take in the next line while this one compiles
     if (state) {
       /*************************/
       /** Compile Mode        **/
       /*************************/
-      if (isWord(cTokenBuffer)) {
+      if (isWord(cpToken, tokenLength)) {
         if (wordFlags & IMMEDIATE) {
           if (w > 255) {
             rPush(0);            // Push 0 as our return address
             ip = (cell_t *)w;    // set the ip to the XT (memory location)
             executeWord();
           } else {
-            function = (func)pgm_read_word(&flashDict[w - 1].function);
-            function();
+            executePrimitive(w);
             if (errorCode) return;
           }
           executeWord();  // Why is this here?
-        } else {
-          *pHere++ = w;
+          pLastOp = NULL; // It may have left a branch target at HERE
+        } else if (w < 256 || !compileInline((cell_t*)w, wordFlags & INLINE)) {
+          compileWord(w);
+        }
+      } else if ((cells = isNumber(cpToken, tokenLength))) {
+        if (cells == 2) {
+          cell_t high = pop();         // Compile the low cell first
+          _literal();
+          push(high);
         }
-      } else if (isNumber(cTokenBuffer)) {
         _literal();
       } else {
         push(-13);
@@ -481,7 +727,7 @@ void interpreter(void) {
       /************************/
       /* Interpret Mode       */
       /************************/
-      if (isWord(cTokenBuffer)) {
+      if (isWord(cpToken, tokenLength)) {
         if (wordFlags & COMP_ONLY) {
           push(-14);
           _throw();
@@ -494,11 +740,10 @@ void interpreter(void) {
           executeWord();
           if (errorCode) return;
         } else {
-          function = (func) pgm_read_word(&flashDict[w - 1].function);
-          function();
+          executePrimitive(w);
           if (errorCode) return;
         }
-      } else if (isNumber(cTokenBuffer)) {
+      } else if (isNumber(cpToken, tokenLength)) {
 // Is something supposed to be here?        
       } else {
         push(-13);
@@ -513,24 +758,463 @@ void interpreter(void) {
 /******************************************************************************/
 /** Virtual Machine that executes Code Space                                 **/
 /******************************************************************************/
+#ifndef EN_FAST_INNER
 void executeWord(void) {
-  func function;
+#ifdef EN_PROFILE
+  if (profiling) {
+    profileWord();
+    return;
+  }
+#endif
   flags |= EXECUTE;
   while (ip != NULL) {
     w = *ip++;
+    STAT(statDispatches++);
     if (w > 255) {
       // ip is an address in code space
       rPush((size_t)ip);        // push the address to return to
       ip = (cell_t*)w;          // set the ip to the new address
     }
     else {
-      function = (func) pgm_read_word(&flashDict[w - 1].function);
-      function();
+      executePrimitive(w);
       if (errorCode) return;
     }
   }
   flags &= ~EXECUTE;
 }
+#else
+/******************************************************************************/
+/** Fast Virtual Machine                                                     **/
+/**   The instruction pointer lives in the local lip, the data stack index   **/
+/**   in t and the top of stack in top. They are written back to ip, tos     **/
+/**   and stack[] only around calls to the flashDict functions. XTs up to    **/
+/**   J_IDX are dispatched through a table of label addresses in flash.      **/
+/**   The primitives handled inline here check the stacks first and, if     **/
+/**   they would fail, fall back to calling the flashDict function so the    **/
+/**   same exception is thrown. Compiled code is the same for both machines. **/
+/******************************************************************************/
+#define SPILL()   if (t >= 0) stack[t] = top; tos = t
+#define RELOAD()  t = tos; if (t >= 0) top = stack[t]
+
+void executeWord(void) {
+  static const void* const dispatch[J_IDX + 1] PROGMEM = {
+    &&call,        &&op_exit,     &&op_literal,  &&call,        &&op_jump,
+    &&op_zjump,    &&call,        &&call,        &&op_do_sys,   &&op_loop_sys,
+    &&call,        &&op_plus_loop_sys, &&call,   &&call,        &&call,
+    &&op_variable, &&op_over,     &&op_equal,    &&op_drop,     &&op_plus,
+    &&op_fetch,    &&op_store,    &&op_dup,      &&op_r_fetch,  &&op_lit_plus,
+    &&op_fetch_plus, &&op_r_fetch_fetch, &&op_dup_zjump, &&op_lit_eq_zjump,
+    &&op_over_eq_zjump, &&op_lit_of, &&call,     &&call,        &&call,
+    &&op_next_sys, &&op_i,        &&op_j
+  };
+  cell_t* lip = ip;
+  int8_t t;
+  cell_t top = 0;                 // Only valid while t >= 0
+  ucell_t index;
+  cell_t n;
+#ifdef EN_PROFILE
+  if (profiling) {
+    profileWord();
+    return;
+  }
+#endif
+  RELOAD();
+  flags |= EXECUTE;
+
+next:
+  if (lip == NULL) goto done;
+  w = *lip++;
+  STAT(statDispatches++);
+  if (w > 255) {
+    // lip is an address in code space
+    if (rtos >= RSTACK_SIZE - 1) goto call;  // rPush() throws the overflow
+    rStack[++rtos] = (size_t)lip;            // push the address to return to
+    lip = (cell_t*)w;                        // set lip to the new address
+    goto next;
+  }
+  if (w > J_IDX) goto call;
+  goto *pgm_read_ptr(&dispatch[w]);
+
+op_exit:
+  if (rtos < 0) goto call;
+  lip = (cell_t*)rStack[rtos--];
+  goto next;
+
+op_literal:
+  if (state || t >= STACK_SIZE - 1) goto call;
+  if (t >= 0) stack[t] = top;
+  top = *lip++;
+  t++;
+  goto next;
+
+op_jump:
+  lip = (cell_t*)((size_t)lip + *lip);
+  goto next;
+
+op_zjump:
+  if (t < 0) goto call;
+  if (!top) lip = (cell_t*)((size_t)lip + *lip);
+  else lip++;
+  if (--t >= 0) top = stack[t];
+  goto next;
+
+op_do_sys:
+  if (t < 1 || rtos >= RSTACK_SIZE - 2) goto call;
+  rStack[++rtos] = loopIndex;
+  rStack[++rtos] = loopLimit;
+  loopLimit = (ucell_t)stack[--t] + LOOP_BIAS;
+  loopIndex = (ucell_t)top - loopLimit;
+  if (--t >= 0) top = stack[t];
+  goto next;
+
+op_loop_sys:
+  if (loopIndex + 1 != LOOP_BIAS) {
+    loopIndex++;
+    lip = (cell_t*)*lip;
+    goto next;
+  }
+  if (rtos < 1) goto call;       // exitLoop() throws the underflow
+  loopLimit = rStack[rtos--];
+  loopIndex = rStack[rtos--];
+  lip++;
+  goto next;
+
+op_plus_loop_sys:
+  if (t < 0 || rtos < 1) goto call;
+  index = loopIndex + top;
+  n = (loopIndex ^ index) & ((ucell_t)top ^ index);
+  if (--t >= 0) top = stack[t];
+  if (n >= 0) {
+    loopIndex = index;
+    lip = (cell_t*)*lip;
+    goto next;
+  }
+  loopLimit = rStack[rtos--];
+  loopIndex = rStack[rtos--];
+  lip++;
+  goto next;
+
+op_next_sys:
+  if (loopIndex != LOOP_BIAS) {
+    loopIndex--;
+    lip = (cell_t*)*lip;
+    goto next;
+  }
+  if (rtos < 1) goto call;
+  loopLimit = rStack[rtos--];
+  loopIndex = rStack[rtos--];
+  lip++;
+  goto next;
+
+op_i:
+  if (t >= STACK_SIZE - 1) goto call;
+  if (t >= 0) stack[t] = top;
+  top = loopIndex + loopLimit;
+  t++;
+  goto next;
+
+op_j:
+  if (t >= STACK_SIZE - 1 || rtos < 1) goto call;
+  if (t >= 0) stack[t] = top;
+  top = rStack[rtos - 1] + rStack[rtos];
+  t++;
+  goto next;
+
+op_variable:
+  if (t >= STACK_SIZE - 1) goto call;
+  if (t >= 0) stack[t] = top;
+  top = (size_t)lip++;
+  t++;
+  goto next;
+
+op_over:
+  if (t < 1 || t >= STACK_SIZE - 1) goto call;
+  stack[t++] = top;
+  top = stack[t - 2];
+  goto next;
+
+op_equal:
+  if (t < 1) goto call;
+  top = (stack[--t] == top) ? TRUE : FALSE;
+  goto next;
+
+op_drop:
+  if (t < 0) goto call;
+  if (--t >= 0) top = stack[t];
+  goto next;
+
+op_plus:
+  if (t < 1) goto call;
+  top += stack[--t];
+  goto next;
+
+op_fetch:
+  if (t < 0) goto call;
+  top = *(cell_t*)top;
+  goto next;
+
+op_store:
+  if (t < 1) goto call;
+  *(cell_t*)top = stack[t - 1];
+  t -= 2;
+  if (t >= 0) top = stack[t];
+  goto next;
+
+op_dup:
+  if (t < 0 || t >= STACK_SIZE - 1) goto call;
+  stack[t++] = top;
+  goto next;
+
+op_r_fetch:
+  if (t >= STACK_SIZE - 1 || rtos < 0) goto call;
+  if (t >= 0) stack[t] = top;
+  top = rStack[rtos];
+  t++;
+  goto next;
+
+op_lit_plus:
+  if (t < 0) goto call;
+  top += *lip++;
+  goto next;
+
+op_fetch_plus:
+  if (t < 1) goto call;
+  top = stack[--t] + *(cell_t*)top;
+  goto next;
+
+op_r_fetch_fetch:
+  if (t >= STACK_SIZE - 1 || rtos < 0) goto call;
+  if (t >= 0) stack[t] = top;
+  top = *(cell_t*)rStack[rtos];
+  t++;
+  goto next;
+
+op_dup_zjump:
+  if (t < 0) goto call;
+  if (!top) lip = (cell_t*)((size_t)lip + *lip);
+  else lip++;
+  goto next;
+
+op_lit_eq_zjump:
+  if (t < 0) goto call;
+  n = *lip++;
+  if (top != n) lip = (cell_t*)((size_t)lip + *lip);
+  else lip++;
+  if (--t >= 0) top = stack[t];
+  goto next;
+
+op_over_eq_zjump:
+  if (t < 1) goto call;
+  n = top;
+  top = stack[--t];
+  if (top != n) lip = (cell_t*)((size_t)lip + *lip);
+  else lip++;
+  goto next;
+
+op_lit_of:
+  if (t < 0) goto call;
+  if (top != *lip++) lip = (cell_t*)((size_t)lip + *lip);
+  else lip++;
+  goto next;
+
+call:
+  SPILL();
+  ip = lip;
+  if (w > 255) {
+    rPush((size_t)ip);
+    ip = (cell_t*)w;
+  } else {
+    executePrimitive(w);
+  }
+  if (errorCode) return;
+  lip = ip;
+  RELOAD();
+  goto next;
+
+done:
+  SPILL();
+  ip = lip;
+  flags &= ~EXECUTE;
+}
+
+#undef SPILL
+#undef RELOAD
+#endif
+
+#ifdef EN_PROFILE
+/******************************************************************************/
+/** Profiled Virtual Machine                                                 **/
+/**   The plain executeWord() loop with accounting, used while profiling is  **/
+/**   on. Every word gets a call count and its self time: for a primitive    **/
+/**   the time its function ran, for a definition the time spent             **/
+/**   dispatching its own body. Time is taken from one clock, profileLast,   **/
+/**   so machines nested by EXECUTE never count the same time twice.         **/
+/******************************************************************************/
+profile_t* profileSlot(cell_t xt) {
+  uint8_t i = (xt ^ (xt >> 3)) & (PROFILE_SIZE - 1);
+  for (uint8_t n = PROFILE_SIZE; n; n--) {
+    if (profile[i].xt == xt) return &profile[i];
+    if (profile[i].xt == 0) {
+      profile[i].xt = xt;
+      return &profile[i];
+    }
+    i = (i + 1) & (PROFILE_SIZE - 1);
+  }
+  return &profileOther;
+}
+
+/******************************************************************************/
+/** Charge the time since the last switch to profileOwner and start timing  **/
+/** xt. An owner of 0 is the outer interpreter, which is not counted.        **/
+/******************************************************************************/
+void profileSwitch(cell_t xt) {
+  unsigned long now = micros();
+  if (profileOwner) profileSlot(profileOwner)->time += now - profileLast;
+  profileLast = now;
+  profileOwner = xt;
+}
+
+void profileEnter(cell_t xt) {
+  profileSwitch(xt);
+  profileSlot(xt)->calls++;
+  if (profileDepth < RSTACK_SIZE) profileCaller[profileDepth++] = profileDef;
+  profileDef = xt;
+}
+
+void profilePrimitive(uint8_t xt) {
+  cell_t owner = profileOwner;
+  profileSwitch(xt);
+  profileSlot(xt)->calls++;
+  executePrimitive(xt);
+  profileSwitch(owner);
+}
+
+void profileWord(void) {
+  static uint8_t nest = 0;       // EXECUTE runs a machine inside another
+  if (nest++ == 0) {
+    profileDepth = 0;            // Forget the calls cut short by an exception
+    profileDef = 0;
+  }
+  flags |= EXECUTE;
+  if (ip != NULL) profileEnter((size_t)ip);
+  while (ip != NULL) {
+    w = *ip++;
+    if (w > 255) {
+      rPush((size_t)ip);        // push the address to return to
+      ip = (cell_t*)w;          // set the ip to the new address
+      profileEnter(w);
+    } else {
+      uint8_t xt = w;
+      profilePrimitive(xt);
+      if (xt == EXIT_IDX && profileDepth) {
+        profileOwner = profileDef = profileCaller[--profileDepth];
+      }
+    }
+    if (errorCode) {
+      nest--;
+      return;
+    }
+  }
+  flags &= ~EXECUTE;
+  nest--;
+}
+#endif
+
+/******************************************************************************/
+/** Cooperative Tasks                                                        **/
+/**   The operator, which runs the outer interpreter in loop(), hands the    **/
+/**   processor to the started tasks whenever it executes PAUSE or MS or     **/
+/**   waits for a key. runTasks() then gives each task that is awake one     **/
+/**   turn, until the task executes PAUSE, MS or STOP or its word ends.      **/
+/**   A switch trades the running stacks with the ones in the task_t,        **/
+/**   copying only the cells in use, so the machines run unchanged.          **/
+/******************************************************************************/
+void swapTask(task_t* t) {
+  cell_t cell;
+  int8_t i;
+  int8_t n;
+
+  for (i = max(tos, t->tos); i >= 0; i--) {
+    cell = stack[i];
+    stack[i] = t->stack[i];
+    t->stack[i] = cell;
+  }
+  for (i = max(rtos, t->rtos); i >= 0; i--) {
+    cell = rStack[i];
+    rStack[i] = t->rStack[i];
+    t->rStack[i] = cell;
+  }
+  n = tos;
+  tos = t->tos;
+  t->tos = n;
+  n = rtos;
+  rtos = t->rtos;
+  t->rtos = n;
+  n = state;
+  state = t->state;
+  t->state = n;
+  cell = loopIndex;
+  loopIndex = t->loopIndex;
+  t->loopIndex = cell;
+  cell = loopLimit;
+  loopLimit = t->loopLimit;
+  t->loopLimit = cell;
+  cell_t* p = ip;
+  ip = t->ip;
+  t->ip = p;
+}
+
+void runTask(task_t* t) {
+  uint8_t savedFlags = flags;    // The task's machine clears EXECUTE
+  char savedIn = *cpToIn;        // An exception in the task ends the line
+
+  swapTask(t);
+  pTask = t;
+  pTaskResume = NULL;
+  executeWord();
+  if (errorCode) {
+    errorCode = 0;
+    pTaskResume = NULL;
+  }
+  ip = pTaskResume;
+  if (ip == NULL) t->status = TASK_STOPPED;
+  pTask = NULL;
+  swapTask(t);
+  *cpToIn = savedIn;
+  flags = savedFlags;
+}
+
+void runTasks(void) {
+  if (pTask) return;             // Only the operator hands out turns
+  serialPoll();
+  for (task_t* t = pTaskList; t; t = (task_t*)t->next) {
+    if (t->status == TASK_RUNNING && (long)(millis() - t->wake) >= 0) {
+      runTask(t);
+    }
+  }
+}
+
+/******************************************************************************/
+/** Execute the primitive with execution token xt. The stack effect declared **/
+/** for it in flashDict[] is checked here, once, so the primitive itself may  **/
+/** use TOP, NOS and the other unchecked stack access.                       **/
+/******************************************************************************/
+void executePrimitive(uint8_t xt) {
+  uint8_t effect = pgm_read_byte(&flashDict[xt - 1].effect);
+  if (effect != NO_EFFECT) {
+    if (tos < EFFECT_IN(effect) - 1) {
+      push(-4);
+      _throw();
+      return;
+    }
+    if (tos - EFFECT_IN(effect) + EFFECT_OUT(effect) >= STACK_SIZE) {
+      stack[tos] = -3;
+      _throw();
+      return;
+    }
+  }
+  ((func)pgm_read_ptr(&flashDict[xt - 1].function))();
+}
 
 /******************************************************************************/
 /** Find the word in the Dictionaries                                        **/
@@ -539,84 +1223,105 @@ void executeWord(void) {
 /**                                                                          **/
 /** Also set wordFlags, from the definition of the word.                     **/
 /**                                                                          **/
+/** Only the hash bucket the name falls in is searched in each dictionary.   **/
+/**                                                                          **/
 /** Could this become the word FIND or ' (tick)?                             **/
 /******************************************************************************/
-uint8_t isWord(char* addr) {
-  uint8_t index = 0;
+uint8_t isWord(const char* addr, uint8_t length) {
+  uint8_t hash = hashName(addr, length);
 
-  pUserEntry = pLastUserEntry;
   // First search through the user dictionary
-  while (pUserEntry) {
-    if (strcmp(pUserEntry->name, addr) == 0) {
-      wordFlags = pUserEntry->flags;
-      w = (size_t)pUserEntry->cfa;
-      return 1;
-    }
-    pUserEntry = (userEntry_t*)pUserEntry->prevEntry;
+  pUserEntry = findUserEntry(addr, length, hash);
+  if (pUserEntry) {
+    wordFlags = pUserEntry->flags;
+    w = (size_t)entryCfa(pUserEntry);
+    return 1;
   }
   // Second Search through the flash Dictionary
-  while(pgm_read_word(&flashDict[index])) {
-    if (!strcasecmp_P(addr, (char*) pgm_read_word(&flashDict[index].name))) {
-      w = index + 1;
-      wordFlags = pgm_read_byte(&(flashDict[index].flags));
-      if (wordFlags & SMUDGE) {
-        return 0;
-      } else {
-        return 1;
-      }
+  w = findFlashEntry(addr, length, hash);
+  if (w) {
+    wordFlags = pgm_read_byte(&(flashDict[w - 1].flags));
+    if (wordFlags & SMUDGE) {
+      return 0;
+    } else {
+      return 1;
     }
-    index++;
   }
-  w = 0;
   return 0;
 }
 
+/******************************************************************************/
+/** Hash the length characters of name for the dictionary searches. See     **/
+/** HASH_STEP in YAFFA.h                                                     **/
+/******************************************************************************/
+uint8_t hashName(const char* name, uint8_t length) {
+  uint8_t hash = 0;
+  while (length--) {
+    hash = HASH_STEP(hash, *name++);
+  }
+  return hash;
+}
+
 /******************************************************************************/
 /** Attempt to interpret token as a number.  If it looks like a number, push **/
-/** it on the stack and return 1.  Otherwise, push nothing and return 0.     **/
+/** it on the stack and return 1, or 2 for a double number.  Otherwise, push **/
+/** nothing and return 0.                                                    **/
 /**                                                                          **/
-/** Numbers without a prefix are assumed to be decimal.  Decimal numbers may **/
-/** have a negative sign in front which does a 2's complement conversion at  **/
-/** the end.  Prefixes are # for decimal, $ for hexadecimal, and % for       **/
-/** binary.                                                                  **/
+/** Numbers are in BASE unless they start with a prefix: # for decimal, $   **/
+/** for hexadecimal, and % for binary. A '-' after any prefix negates the    **/
+/** number, and a '.' at the end makes it a double number. Digits are looked **/
+/** up in digitValue[]. Only a double number is built in a double cell.      **/
 /******************************************************************************/
-uint8_t isNumber(char* subString) {
-  unsigned char negate = 0;                  // flag if number is negative
-  cell_t tempBase = base;
-  cell_t number = 0;
+uint8_t isNumber(const char* token, uint8_t length) {
+  const char* end = token + length;
+  uint8_t radix = base;
+  bool negate = false;
+  ucell_t number = 0;
+  uint8_t digit;
 
   wordFlags = 0;
-
-  // Look at the initial character, handling either '-', '$', or '%'
-  switch (*subString) {
-    case '$':  base = HEXIDECIMAL;  goto SKIP;
-    case '%':  base = BINARY;   goto SKIP;
-    case '#':  base = DECIMAL;  goto SKIP;
-    case '-':  negate = 1;
-SKIP:                // common code to skip initial character
-    subString++;
-    break;
-  }
-  // Iterate over rest of token, and if rest of digits are in
-  // the valid set of characters, accumulate them.  If any
-  // invalid characters found, abort and return 0.
-  while (*subString) {
-    PGM_P pos = strchr_P(charset, (int)tolower(*subString));
-    cell_t offset = pos - charset;
-    if ((offset < base) && (offset > -1))
-      number = (number * base) + (pos - charset);
-    else {
-      base = tempBase;
-      return 0;           // exit, signalling subString isn't a number
-    }
-    subString++;
+  switch (*token) {
+    case '$':  radix = HEXIDECIMAL;  token++;  break;
+    case '%':  radix = BINARY;  token++;  break;
+    case '#':  radix = DECIMAL;  token++;  break;
+  }
+  if (token < end && *token == '-') {
+    negate = true;
+    token++;
+  }
+  if (token < end && end[-1] == '.') {
+    udcell_t ud = 0;
+    if (token == --end || toNumber(&ud, token, end, radix) != end) return 0;
+    if (negate) ud = -ud;
+    push((cell_t)ud);
+    push((cell_t)(ud >> CELL_BITS));
+    return 2;
   }
-  if (negate) number = ~number + 1;     // apply sign, if necessary
-  push(number);
-  base = tempBase;
+  if (token == end) return 0;
+  while (token < end) {
+    digit = pgm_read_byte(&digitValue[(uint8_t)*token++]);
+    if (digit >= radix) return 0;     // Not a number
+    number = number * radix + digit;
+  }
+  push(negate ? -number : number);
   return 1;
 }
 
+/******************************************************************************/
+/** Convert the digits from p up to end in radix, adding each into *ud after **/
+/** multiplying it by radix. Returns the first character that is not a      **/
+/** digit, or end.                                                           **/
+/******************************************************************************/
+const char* toNumber(udcell_t* ud, const char* p, const char* end, uint8_t radix) {
+  uint8_t digit;
+  for ( ; p < end; p++) {
+    digit = pgm_read_byte(&digitValue[(uint8_t)*p]);
+    if (digit >= radix) break;
+    *ud = *ud * radix + digit;
+  }
+  return p;
+}
+
 /******************************************************************************/
 /** freeHeap returns the amount of free heap remaining.                      **/
 /******************************************************************************/
@@ -637,47 +1342,410 @@ SKIP:                // common code to skip initial character
 /** freeMem returns the amount of free forth space left.                     **/
 /******************************************************************************/
 static unsigned int freeMem(void) {
-  return (((int)&forthSpace[FORTH_SIZE] - (int)pHere) / sizeof(cell_t));
+  return (((size_t)pNames - (size_t)pHere) / sizeof(cell_t));
+}
+
+/******************************************************************************/
+/** User Dictionary Links                                                    **/
+/**   prevEntry() and prevInBucket() follow the links of an entry, and       **/
+/**   entryCfa() finds its code field, see userEntry_t. linkTo() makes a     **/
+/**   link from an entry to an older one and throws if it is too far.        **/
+/******************************************************************************/
+userEntry_t* prevEntry(userEntry_t* e) {
+  if (!e->prevEntry) return NULL;
+  if (e->flags & PRIVATE) return (userEntry_t*)((cell_t*)e + e->prevEntry);
+  return (userEntry_t*)((cell_t*)e - e->prevEntry);
+}
+
+userEntry_t* prevInBucket(userEntry_t* e) {
+  if (!e->prevInBucket) return NULL;
+  return (userEntry_t*)((cell_t*)e - e->prevInBucket);
+}
+
+cell_t* entryCfa(userEntry_t* e) {
+  cell_t* cfa = (cell_t*)(e->name + strlen(e->name) + 1);
+  ALIGN_P(cfa);
+  if (e->flags & PRIVATE) return (cell_t*)*cfa;
+  return cfa;
+}
+
+link_t linkTo(userEntry_t* from, userEntry_t* to) {
+  if (to == NULL) return 0;
+  size_t cells = (from > to ? (size_t)from - (size_t)to :
+                              (size_t)to - (size_t)from) / sizeof(cell_t);
+  if (cells > LINK_MAX) {
+    push(-8);
+    _throw();
+    return 0;
+  }
+  return cells;
+}
+
+/******************************************************************************/
+/** Search the user dictionary for the length characters at name, the       **/
+/** private headers first and then the hash bucket of the public ones.       **/
+/** Returns NULL if it is not there.                                         **/
+/******************************************************************************/
+userEntry_t* findUserEntry(const char* name, uint8_t length, uint8_t hash) {
+  userEntry_t* e;
+  for (e = pLastPrivate; e; e = prevEntry(e)) {
+    if (strncmp(e->name, name, length) == 0 && e->name[length] == 0) return e;
+  }
+  for (e = userBucket[hash & (USER_BUCKETS - 1)]; e; e = prevInBucket(e)) {
+    if (strncmp(e->name, name, length) == 0 && e->name[length] == 0) return e;
+  }
+  return NULL;
+}
+
+/******************************************************************************/
+/** Entry of the user word xt, or NULL if it has no header                   **/
+/******************************************************************************/
+userEntry_t* xtToEntry(cell_t xt) {
+  userEntry_t* e;
+  for (e = pLastPrivate; e; e = prevEntry(e)) {
+    if (entryCfa(e) == (cell_t*)xt) return e;
+  }
+  for (e = pLastUserEntry; e; e = prevEntry(e)) {
+    if (entryCfa(e) == (cell_t*)xt) return e;
+  }
+  return NULL;
 }
 
 /******************************************************************************/
 /** Start a New Entry in the Dictionary                                      **/
+/**   The header goes at HERE, or at the bottom of the name region after     **/
+/**   PRIVATE. Either way the code starts at HERE.                           **/
 /******************************************************************************/
 void openEntry(void) {
-  uint8_t index = 0;
+  char* ptr;
   pOldHere = pHere;            // Save the old location of HERE so we can
                                // abort out of the new definition
-  pNewUserEntry = (userEntry_t*)pHere;
-  if (pLastUserEntry == NULL)
-    pNewUserEntry->prevEntry = 0;              // Initialize User Dictionary
-  else pNewUserEntry->prevEntry = pLastUserEntry;
+  ALIGN_P(pHere);
   if (!getToken()) {
     push(-16);
     _throw();
+    return;
+  }
+  if (tokenLength > WORD_SIZE - 1) {   // Lookups compare the whole token
+    push(-19);
+    _throw();
+    return;
+  }
+  if (privateHeaders) {
+    size_t size = offsetof(userEntry_t, name) + strlen(cTokenBuffer) + 1;
+    ALIGN(size);
+    ptr = pNames - size - sizeof(cell_t);   // Name, then the code field
+    if ((cell_t*)ptr <= pHere) {
+      push(-8);
+      _throw();
+      return;
+    }
+    pNewUserEntry = (userEntry_t*)ptr;
+    pNewUserEntry->flags = PRIVATE;
+    pNewUserEntry->prevEntry = linkTo(pNewUserEntry, pLastPrivate);
+    pNewUserEntry->prevInBucket = 0;
+  } else {
+    pNewUserEntry = (userEntry_t*)pHere;
+    pNewUserEntry->flags = NORMAL;
+    pNewUserEntry->prevEntry = linkTo(pNewUserEntry, pLastUserEntry);
+  }
+  strcpy(pNewUserEntry->name, cTokenBuffer);
+  ptr = pNewUserEntry->name + strlen(cTokenBuffer) + 1;
+  if (privateHeaders) {
+    cell_t* cfa = (cell_t*)ptr;
+    ALIGN_P(cfa);
+    *cfa = (size_t)pHere;            // The code field address
+  } else {
+    pHere = (cell_t *)ptr;
+    ALIGN_P(pHere);
   }
-  char* ptr = pNewUserEntry->name;
-  do {
-    *ptr++ = cTokenBuffer[index++];
-  } while (cTokenBuffer[index] != '\0');
-  *ptr++ = '\0';
-  pHere = (cell_t *)ptr;
-  ALIGN_P(pHere);
-  pNewUserEntry->cfa = pHere;
   pCodeStart = pHere;
+  pLastOp = NULL;
 }
 
 /******************************************************************************/
 /** Finish an new Entry in the Dictionary                                    **/
 /******************************************************************************/
 void closeEntry(void) {
+  userEntry_t** bucket = NULL;
+  if (errorCode == 0 && !(pNewUserEntry->flags & PRIVATE)) {
+    bucket = &userBucket[hashName(pNewUserEntry->name, strlen(pNewUserEntry->name)) & (USER_BUCKETS - 1)];
+    pNewUserEntry->prevInBucket = linkTo(pNewUserEntry, *bucket);
+  }
   if (errorCode == 0) {
     *pHere++ = EXIT_IDX;
-    pNewUserEntry->flags = 0; // clear the word's flags
-    pLastUserEntry = pNewUserEntry;
+    pNewUserEntry->flags &= PRIVATE; // clear the word's flags
+    if (pNewUserEntry->flags & PRIVATE) {
+      pLastPrivate = pNewUserEntry;
+      pNames = (char*)pNewUserEntry;
+    } else {
+      pLastUserEntry = pNewUserEntry;
+      // Link the entry in at the head of its hash bucket
+      *bucket = pNewUserEntry;
+    }
+    pLatest = pNewUserEntry;
+    STAT(if (pHere > pStatPeakHere) pStatPeakHere = pHere);
   } else pHere = pOldHere;   // Revert pHere to what it was before the start
                              // of the new word definition
 }
 
+/******************************************************************************/
+/** Rebuild the heads of the user hash buckets from pLastUserEntry. Entries  **/
+/** keep their prevInBucket links, so each head is the newest entry found.   **/
+/******************************************************************************/
+void linkUserBuckets(void) {
+  memset(userBucket, 0, sizeof(userBucket));
+  for (userEntry_t* e = pLastUserEntry; e; e = prevEntry(e)) {
+    userEntry_t** bucket = &userBucket[hashName(e->name, strlen(e->name)) & (USER_BUCKETS - 1)];
+    if (*bucket == NULL) *bucket = e;
+  }
+}
+
+/******************************************************************************/
+/** Remove entry e and every definition made after it, for MARKER and        **/
+/** FORGET. The private headers of the words removed go too, as do the tasks **/
+/** whose control blocks were in the space given back.                       **/
+/******************************************************************************/
+void forgetEntry(userEntry_t* e) {
+  pHere = (e->flags & PRIVATE) ? entryCfa(e) : (cell_t*)e;
+  pOldHere = pHere;
+  while (pLastUserEntry && (cell_t*)pLastUserEntry >= pHere) {
+    pLastUserEntry = prevEntry(pLastUserEntry);
+  }
+  linkUserBuckets();
+  while (pLastPrivate && entryCfa(pLastPrivate) >= pHere) {
+    pLastPrivate = prevEntry(pLastPrivate);
+  }
+  if (pLastPrivate) pNames = (char*)pLastPrivate;
+  else pNames = (char*)&forthSpace[FORTH_SIZE];
+  pLatest = NULL;
+  for (task_t** t = &pTaskList; *t; ) {
+    if ((cell_t*)*t >= pHere) *t = (task_t*)(*t)->next;
+    else t = (task_t**)&(*t)->next;
+  }
+#ifdef EN_PROFILE
+  _profile_reset();            // Its XTs may be reused
+#endif
+}
+
+/******************************************************************************/
+/** Compile a Word into the Current Definition                               **/
+/**                                                                          **/
+/** Appends xt at HERE. If xt and the last one or two instructions compiled  **/
+/** here form a sequence with a fused primitive, those instructions are      **/
+/** rewritten in place instead. Any operand (the value of a literal, the     **/
+/** offset of a zjump) is stored by the caller after the call as usual.      **/
+/** The interpreter clears pLastOp after each immediate word, so a fusion    **/
+/** never spans a branch target.                                             **/
+/******************************************************************************/
+void compileWord(cell_t xt) {
+  cell_t* last = pLastOp;
+  cell_t* prev = pPrevOp;
+  uint8_t fused = 0;
+
+  // Only look back at plain instructions that end right at HERE
+  if (last && last + (*last == LITERAL_IDX ? 2 : 1) != pHere) last = NULL;
+  if (last == NULL ||
+      (prev && prev + (*prev == LITERAL_IDX ? 2 : 1) != last)) prev = NULL;
+
+  if (last) {
+    switch (xt) {
+      case PLUS_IDX:
+        if (*last == LITERAL_IDX) fused = LIT_PLUS_IDX;
+        else if (*last == FETCH_IDX) fused = FETCH_PLUS_IDX;
+        break;
+      case FETCH_IDX:
+        if (*last == R_FETCH_IDX) fused = R_FETCH_FETCH_IDX;
+        break;
+      case ZJUMP_IDX:
+        if (*last == DUP_IDX) fused = DUP_ZJUMP_IDX;
+        else if (*last == EQUAL_IDX && prev) {
+          if (*prev == LITERAL_IDX) fused = LIT_EQ_ZJUMP_IDX;
+          else if (*prev == OVER_IDX) fused = OVER_EQ_ZJUMP_IDX;
+          if (fused) {
+            pHere = last;            // Drop the "="
+            last = prev;
+          }
+        }
+        break;
+      case OVER_EQ_ZJUMP_IDX:
+        if (*last == LITERAL_IDX) fused = LIT_OF_IDX;
+        break;
+    }
+  }
+
+  if (fused) {
+    *last = fused;
+    pLastOp = last;
+    pPrevOp = NULL;
+  } else {
+    pPrevOp = last;
+    pLastOp = pHere;
+    *pHere++ = xt;
+  }
+}
+
+/******************************************************************************/
+/** Inline Expansion                                                         **/
+/**                                                                          **/
+/** Calling a colon definition costs a dispatch for the call, one for its    **/
+/** exit and a return stack cell. compileInline() copies the body of the     **/
+/** definition at xt into the current one instead when the body is at most  **/
+/** inlineLimit cells long, or the word was marked with INLINE. Bodies that  **/
+/** use DOES>, RECURSE, a data field, the return stack or exit early are     **/
+/** always called, even with INLINE. Jump offsets are relative and copy as   **/
+/** is; the absolute loop addresses are relocated. Returns false if a call   **/
+/** should be compiled instead.                                              **/
+/******************************************************************************/
+cell_t inlineLimit = INLINE_SIZE;  // Set through INLINE-LIMIT
+
+/******************************************************************************/
+/** True for the primitives that read or change the return stack. Copied     **/
+/** into a caller they would find its cells where the return address was.    **/
+/******************************************************************************/
+bool usesReturnStack(cell_t op) {
+  if (op == R_FETCH_IDX || op == R_FETCH_FETCH_IDX || op == J_IDX) return true;
+  if (op < 1 || op > 255) return false;
+  func function = (func)pgm_read_ptr(&flashDict[op - 1].function);
+  return function == _to_r || function == _r_from || function == _two_to_r ||
+         function == _two_r_from || function == _two_r_fetch ||
+         function == _unloop;
+}
+
+/******************************************************************************/
+/** Address of the instruction following the one at p and its operands.      **/
+/******************************************************************************/
+cell_t* nextOp(cell_t* p) {
+  switch (*p) {
+    case LIT_EQ_ZJUMP_IDX:
+    case LIT_OF_IDX:
+      return p + 3;
+    case LITERAL_IDX:
+    case JUMP_IDX:
+    case ZJUMP_IDX:
+    case SUBROUTINE_IDX:
+    case LOOP_SYS_IDX:
+    case LEAVE_SYS_IDX:
+    case PLUS_LOOP_SYS_IDX:
+    case QDO_SYS_IDX:
+    case FOR_SYS_IDX:
+    case NEXT_SYS_IDX:
+    case VARIABLE_IDX:
+    case LIT_PLUS_IDX:
+    case DUP_ZJUMP_IDX:
+    case OVER_EQ_ZJUMP_IDX:
+      return p + 2;
+    case S_QUOTE_IDX:
+    case DOT_QUOTE_IDX:
+      char* ptr = (char*)(p + 1);
+      p = (cell_t*)(ptr + strlen(ptr) + 1);
+      ALIGN_P(p);
+      return p;
+  }
+  return p + 1;
+}
+
+bool compileInline(cell_t* xt, bool force) {
+  cell_t* end = xt;
+  cell_t* reach = xt;      // Furthest forward branch target seen
+  cell_t* target;
+  bool branches = false;
+
+  // A CREATEd word, see CREATE_BODY. A later DOES> may change what it does.
+  if (xt[0] == LITERAL_IDX && xt[1] == (cell_t)(size_t)(xt + CREATE_BODY))
+    return false;
+
+  while (*end != EXIT_IDX) {
+    switch (*end) {
+      case SUBROUTINE_IDX:
+      case VARIABLE_IDX:
+        return false;
+      case LIT_EQ_ZJUMP_IDX:
+      case LIT_OF_IDX:
+        target = (cell_t*)((size_t)(end + 2) + end[2]);
+        break;
+      case JUMP_IDX:
+      case ZJUMP_IDX:
+      case DUP_ZJUMP_IDX:
+      case OVER_EQ_ZJUMP_IDX:
+        target = (cell_t*)((size_t)(end + 1) + end[1]);
+        break;
+      case LEAVE_SYS_IDX:
+      case LOOP_SYS_IDX:
+      case PLUS_LOOP_SYS_IDX:
+      case QDO_SYS_IDX:
+      case FOR_SYS_IDX:
+      case NEXT_SYS_IDX:
+        target = (cell_t*)end[1];
+        break;
+      default:
+        if (*end == (cell_t)(size_t)xt) return false;  // RECURSE
+        if (usesReturnStack(*end)) return false;
+        target = NULL;
+    }
+    if (target) {
+      branches = true;
+      if (target > reach) reach = target;
+    }
+    end = nextOp(end);
+    if (!force && (size_t)end - (size_t)xt > inlineLimit * sizeof(cell_t))
+      return false;
+  }
+  if (end < reach) return false;   // An early EXIT, code follows it
+  if ((size_t)end - (size_t)xt >= freeMem() * sizeof(cell_t)) return false;
+
+  if (!branches) {
+    // Straight line code can go through the peephole optimizer
+    for (cell_t* p = xt; p < end; ) {
+      cell_t* next = nextOp(p);
+      compileWord(*p);
+      memcpy(pHere, p + 1, (size_t)next - (size_t)(p + 1));
+      pHere = (cell_t*)((size_t)pHere + (size_t)next - (size_t)(p + 1));
+      p = next;
+    }
+  } else {
+    cell_t delta = (size_t)pHere - (size_t)xt;
+    cell_t* p = pHere;
+    memcpy(pHere, xt, (size_t)end - (size_t)xt);
+    pHere = (cell_t*)((size_t)pHere + (size_t)end - (size_t)xt);
+    for ( ; p < pHere; p = nextOp(p)) {
+      switch (*p) {
+        case LEAVE_SYS_IDX:
+        case LOOP_SYS_IDX:
+        case PLUS_LOOP_SYS_IDX:
+        case QDO_SYS_IDX:
+        case FOR_SYS_IDX:
+        case NEXT_SYS_IDX:
+          p[1] += delta;
+      }
+    }
+    pLastOp = NULL;        // The copy may hold branch targets
+  }
+  return true;
+}
+
+/******************************************************************************/
+/** Close the loop opened at the address on the control-flow stack: compile  **/
+/** op with the address of the loop body, then point the ?DO or FOR and the  **/
+/** LEAVEs in the loop that are not resolved yet past it. The opening word   **/
+/** pushed sys under its address, else -22 is thrown.                        **/
+/******************************************************************************/
+void closeLoop(cell_t op, cell_t sys) {
+  cell_t* orig = (cell_t*)pop();
+  if (errorCode) return;
+  if (pop() != sys) {
+    push(-22);
+    _throw();
+    return;
+  }
+  *pHere++ = op;
+  *pHere++ = (size_t)nextOp(orig);
+  for (cell_t* p = orig; p < pHere; p = nextOp(p)) {
+    if ((*p == QDO_SYS_IDX || *p == FOR_SYS_IDX || *p == LEAVE_SYS_IDX) &&
+        p[1] == 0) p[1] = (size_t)pHere;
+  }
+}
+
 /******************************************************************************/
 /** Stack Functions                                                          **/
 /**   Data Stack "stack" - A stack that may be used for passing parameters   **/
@@ -737,6 +1805,16 @@ cell_t rPop(void) {
   return 0;
 }
 
+/******************************************************************************/
+/** Unchecked Stack Access                                                   **/
+/**   Only for primitives with an EFFECT() in flashDict[], and for code they **/
+/**   call with the stack already checked. TOP is the top of the data stack  **/
+/**   and NOS the cell below it.                                             **/
+/******************************************************************************/
+#define TOP       stack[tos]
+#define NOS       stack[tos - 1]
+#define PUSH(x)   (stack[tos + 1] = (x), tos++)
+
 void showRStack(void) {
   int idx;
   Serial.print("\tR: ");
@@ -767,15 +1845,15 @@ void displayValue(void) {
       break;
     case HEXIDECIMAL:
       serial_print_P(hexidecimal_str); 
-      Serial.print(w, HEX);
+      Serial.print((ucell_t)w, HEX);
       break;
     case OCTAL:
       serial_print_P(octal_str);
-      Serial.print(w, OCT);
+      Serial.print((ucell_t)w, OCT);
       break;
     case BINARY:  
       serial_print_P(binary_str); 
-      Serial.print(w, BIN);
+      Serial.print((ucell_t)w, BIN);
       break;
   }
   serial_print_P(sp_str);
@@ -797,19 +1875,12 @@ uint8_t serial_print_P(PGM_P ptr) {
 /**   Used by _see and _toName                                               **/
 /******************************************************************************/
 char* xtToName(cell_t xt) {
-  pUserEntry = pLastUserEntry;
-
   // Second Search through the flash Dictionary
   if (xt < 256) {
-    serial_print_P((char*)pgm_read_word(&flashDict[xt-1].name));
+    serial_print_P((char*)pgm_read_ptr(&flashDict[xt-1].name));
   } else {
-    while (pUserEntry) {
-      if (pUserEntry->cfa == (cell_t*)xt) {
-        Serial.print(pUserEntry->name);
-        break;
-      }
-      pUserEntry = (userEntry_t*)pUserEntry->prevEntry;
-    }
+    pUserEntry = xtToEntry(xt);
+    if (pUserEntry) Serial.print(pUserEntry->name);
   }
   return 0;
 }
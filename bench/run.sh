@@ -0,0 +1,50 @@
+#!/bin/sh
+################################################################################
+##  YAFFA - Yet Another Forth for Arduino                                     ##
+##                                                                            ##
+##  File: bench/run.sh                                                        ##
+##  Runs each benchmark through the hosted build, ends it with .STATS and     ##
+##  prints one line per program. Exits non-zero if a program threw.           ##
+##                                                                            ##
+##    sh bench/run.sh [program.fth ...]     (default: every bench/*.fth)      ##
+##                                                                            ##
+##  YAFFA  - the binary to run (default build/yaffa)                          ##
+##  REPEAT - how many copies of compile.fth are fed in (default 200)          ##
+################################################################################
+YAFFA=${YAFFA:-build/yaffa}
+REPEAT=${REPEAT:-200}
+input=${TMPDIR:-/tmp}/yaffa-bench.$$
+status=0
+trap 'rm -f "$input"' EXIT
+
+[ $# -gt 0 ] || set -- "$(dirname "$0")"/*.fth
+
+printf '%-8s %8s %12s %14s %12s %10s %6s %7s\n' \
+  program ms dispatches dispatches/s tokens/s bytes stack rstack
+for program in "$@"; do
+  name=$(basename "$program" .fth)
+  copies=1
+  [ "$name" = compile ] && copies=$REPEAT
+  : > "$input"
+  i=0
+  while [ $i -lt $copies ]; do
+    cat "$program" >> "$input"
+    i=$((i + 1))
+  done
+  echo .stats >> "$input"
+
+  "$YAFFA" < "$input" | tr -d '\r' | awk -v name="$name" '
+    /EXCEPTION/     { failed = 1 }
+    /^ Elapsed:/    { ms = $2 }
+    /^ Dispatches:/ { dispatches = $2; rate = $3; gsub(/[^0-9]/, "", rate) }
+    /^ Tokens:/     { tokens = $3; gsub(/[^0-9]/, "", tokens) }
+    /^ Forth Space:/  { space = $3 }
+    /^ Data Stack:/   { stack = $3 }
+    /^ Return Stack:/ { rstack = $3 }
+    END {
+      if (failed || ms == "") { printf "%-8s failed\n", name; exit 1 }
+      printf "%-8s %8d %12d %14d %12d %10d %6d %7d\n",
+        name, ms, dispatches, rate, tokens, space, stack, rstack
+    }' || status=1
+done
+exit $status
@@ -0,0 +1,219 @@
+/******************************************************************************/
+/**  YAFFA - Yet Another Forth for Arduino                                   **/
+/**                                                                          **/
+/**  File: host/Arduino.cpp                                                  **/
+/**  POSIX implementation of the Arduino calls YAFFA uses, for the hosted    **/
+/**  build. Serial is stdin/stdout, EEPROM a byte array that may be backed   **/
+/**  by a file, and time comes from clock_gettime().                         **/
+/**                                                                          **/
+/******************************************************************************/
+#include <Arduino.h>
+#include <EEPROM.h>
+#include <MemoryFree.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <stdio.h>
+#include <time.h>
+#include <unistd.h>
+
+void setup(void);
+void loop(void);
+
+HostSerial Serial;
+EEPROMClass EEPROM;
+
+/******************************************************************************/
+/** Serial - stdin/stdout. LF is delivered as CR so text files end lines.    **/
+/** At the end of input the program ends the next time the sketch idles in  **/
+/** yield(), so the sketch still gets to read what it has buffered.          **/
+/******************************************************************************/
+static uint8_t rxBuffer[256];
+static ssize_t rxHead = 0, rxTail = 0;
+static bool rxEnd = false;
+
+int HostSerial::available(void) {
+  if (rxHead < rxTail) return rxTail - rxHead;
+  if (rxEnd) return 0;
+  fflush(stdout);
+  struct pollfd pfd = { 0, POLLIN, 0 };
+  if (poll(&pfd, 1, 0) <= 0) {
+    usleep(1000);
+    return 0;
+  }
+  ssize_t n = ::read(0, rxBuffer, sizeof(rxBuffer));
+  if (n <= 0) {
+    rxEnd = true;
+    return 0;
+  }
+  rxHead = 0;
+  rxTail = n;
+  return n;
+}
+
+int HostSerial::read(void) {
+  if (!available()) return -1;
+  uint8_t c = rxBuffer[rxHead++];
+  return c == '\n' ? '\r' : c;
+}
+
+void HostSerial::flush(void) {
+  fflush(stdout);
+}
+
+size_t HostSerial::write(uint8_t c) {
+  if (c == '\r') return 1;      // the host terminal only wants the LF
+  putchar(c);
+  return 1;
+}
+
+size_t HostSerial::print(const char *s) {
+  size_t n = 0;
+  while (*s) n += write(*s++);
+  return n;
+}
+
+size_t HostSerial::printNumber(unsigned long long n, int base) {
+  char buf[8 * sizeof(n) + 1];
+  char *str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return print(str);
+}
+
+size_t HostSerial::print(double n, int digits) {
+  char buf[64];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return print(buf);
+}
+
+size_t HostSerial::printSigned(long long n, unsigned long long u, int base) {
+  if (base != DEC) return printNumber(u, base);
+  if (n < 0) return write('-') + printNumber(-(unsigned long long)n, DEC);
+  return printNumber(n, DEC);
+}
+
+/******************************************************************************/
+/** EEPROM - a byte array, optionally backed by the file named in the        **/
+/** YAFFA_EEPROM environment variable.                                       **/
+/******************************************************************************/
+static uint8_t eeprom[E2END + 1];
+static int eepromFd = -2;
+
+static void eepromOpen(void) {
+  const char *path = getenv("YAFFA_EEPROM");
+  memset(eeprom, 0xff, sizeof(eeprom));
+  eepromFd = -1;
+  if (!path) return;
+  eepromFd = open(path, O_RDWR | O_CREAT, 0644);
+  if (eepromFd < 0) return;
+  ssize_t n = pread(eepromFd, eeprom, sizeof(eeprom), 0);
+  if (n < 0) {
+    eepromFd = -1;
+  } else if ((size_t)n < sizeof(eeprom)) {
+    // Fill the file out as erased, or a write near the top leaves a hole
+    // that reads back as zeros
+    if (pwrite(eepromFd, eeprom + n, sizeof(eeprom) - n, n) < 0) perror("eeprom");
+  }
+}
+
+uint8_t EEPROMClass::read(int idx) {
+  if (eepromFd == -2) eepromOpen();
+  if (idx < 0 || idx > E2END) return 0xff;
+  return eeprom[idx];
+}
+
+void EEPROMClass::write(int idx, uint8_t val) {
+  if (eepromFd == -2) eepromOpen();
+  if (idx < 0 || idx > E2END) return;
+  eeprom[idx] = val;
+  if (eepromFd >= 0) {
+    if (pwrite(eepromFd, &val, 1, idx) < 0) perror("eeprom");
+  }
+}
+
+void EEPROMClass::update(int idx, uint8_t val) {
+  if (read(idx) != val) write(idx, val);
+}
+
+void yield(void) {
+  if (rxEnd && rxHead == rxTail) {
+    fflush(stdout);
+    exit(0);
+  }
+}
+
+/******************************************************************************/
+/** Time                                                                     **/
+/******************************************************************************/
+static unsigned long long nowMicros(void) {
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return (unsigned long long)ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static unsigned long long startMicros = nowMicros();
+
+unsigned long millis(void) {
+  return (unsigned long)((nowMicros() - startMicros) / 1000);
+}
+
+unsigned long micros(void) {
+  return (unsigned long)(nowMicros() - startMicros);
+}
+
+void delay(unsigned long ms) {
+  fflush(stdout);
+  usleep(ms * 1000);
+}
+
+void delayMicroseconds(unsigned int us) {
+  usleep(us);
+}
+
+/******************************************************************************/
+/** Pins - simulated. Inputs read back the last value written, and default   **/
+/** to HIGH so the EEPROM load inhibit pin is not asserted.                  **/
+/******************************************************************************/
+static uint8_t pins[64];
+static int analogPins[16];
+
+void pinMode(uint8_t pin, uint8_t mode) {
+  (void)pin;
+  (void)mode;
+}
+
+void digitalWrite(uint8_t pin, uint8_t val) {
+  pins[pin & 63] = val ? HIGH + 1 : LOW + 1;
+}
+
+int digitalRead(uint8_t pin) {
+  uint8_t v = pins[pin & 63];
+  return v ? v - 1 : HIGH;
+}
+
+int analogRead(uint8_t pin) {
+  return analogPins[pin & 15];
+}
+
+void analogWrite(uint8_t pin, int val) {
+  analogPins[pin & 15] = val;
+}
+
+int freeMemory(void) {
+  return 0;
+}
+
+/******************************************************************************/
+/** Arduino style entry point                                                **/
+/******************************************************************************/
+int main(void) {
+  setup();
+  for (;;) loop();
+}
@@ -0,0 +1,80 @@
+/******************************************************************************/
+/**  YAFFA - Yet Another Forth for Arduino                                   **/
+/**                                                                          **/
+/**  File: host/Arduino.h                                                    **/
+/**  The subset of the Arduino core YAFFA uses, for the hosted build. See    **/
+/**  host/Arduino.cpp and the Makefile.                                      **/
+/**                                                                          **/
+/******************************************************************************/
+#ifndef Arduino_h
+#define Arduino_h
+
+#include <stddef.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <math.h>
+#include <avr/pgmspace.h>
+
+#define HIGH 0x1
+#define LOW  0x0
+#define INPUT 0x0
+#define OUTPUT 0x1
+
+#define DEC 10
+#define HEX 16
+#define OCT 8
+#define BIN 2
+
+class __FlashStringHelper;
+#define F(s) (reinterpret_cast<const __FlashStringHelper *>(s))
+
+class HostSerial {
+  public:
+    void begin(unsigned long baud) { (void)baud; }
+    int available(void);
+    int read(void);
+    void flush(void);
+    void setTimeout(unsigned long timeout) { (void)timeout; }
+    size_t write(uint8_t c);
+
+    size_t print(const __FlashStringHelper *s) { return print((const char *)s); }
+    size_t print(const char *s);
+    size_t print(char c) { return write(c); }
+    size_t print(unsigned char n, int base = DEC) { return printNumber(n, base); }
+    size_t print(int n, int base = DEC) { return printSigned(n, (unsigned int)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return printNumber(n, base); }
+    size_t print(long n, int base = DEC) { return printSigned(n, (unsigned long)n, base); }
+    size_t print(unsigned long n, int base = DEC) { return printNumber(n, base); }
+    size_t print(long long n, int base = DEC) { return printSigned(n, (unsigned long long)n, base); }
+    size_t print(unsigned long long n, int base = DEC) { return printNumber(n, base); }
+    size_t print(double n, int digits = 2);
+
+    size_t println(void) { return write('\r') + write('\n'); }
+    template <typename T> size_t println(T v) { size_t n = print(v); return n + println(); }
+    template <typename T> size_t println(T v, int base) { size_t n = print(v, base); return n + println(); }
+
+  private:
+    size_t printNumber(unsigned long long n, int base);
+    size_t printSigned(long long n, unsigned long long u, int base);
+};
+
+extern HostSerial Serial;
+
+#define min(a, b) ((a) < (b) ? (a) : (b))
+#define max(a, b) ((a) > (b) ? (a) : (b))
+
+void yield(void);
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t val);
+int digitalRead(uint8_t pin);
+int analogRead(uint8_t pin);
+void analogWrite(uint8_t pin, int val);
+
+#endif
@@ -0,0 +1,25 @@
+/******************************************************************************/
+/**  YAFFA - Yet Another Forth for Arduino                                   **/
+/**                                                                          **/
+/**  File: host/EEPROM.h                                                     **/
+/**  EEPROM, kept in host/Arduino.cpp.                                       **/
+/**                                                                          **/
+/******************************************************************************/
+#ifndef EEPROM_h
+#define EEPROM_h
+
+#include <stdint.h>
+
+#define E2END 0x3FF
+
+class EEPROMClass {
+  public:
+    uint8_t read(int idx);
+    void write(int idx, uint8_t val);
+    void update(int idx, uint8_t val);
+    uint16_t length(void) { return E2END + 1; }
+};
+
+extern EEPROMClass EEPROM;
+
+#endif
@@ -0,0 +1,13 @@
+/******************************************************************************/
+/**  YAFFA - Yet Another Forth for Arduino                                   **/
+/**                                                                          **/
+/**  File: host/MemoryFree.h                                                 **/
+/**  freeMemory(), which has nothing to report on the host.                  **/
+/**                                                                          **/
+/******************************************************************************/
+#ifndef MEMORY_FREE_H
+#define MEMORY_FREE_H
+
+int freeMemory(void);
+
+#endif
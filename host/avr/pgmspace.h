@@ -0,0 +1,34 @@
+/******************************************************************************/
+/**  YAFFA - Yet Another Forth for Arduino                                   **/
+/**                                                                          **/
+/**  File: host/avr/pgmspace.h                                               **/
+/**  PROGMEM is ordinary memory on the host.                                 **/
+/**                                                                          **/
+/******************************************************************************/
+#ifndef __PGMSPACE_H_
+#define __PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+#include <strings.h>
+
+#define PROGMEM
+#define PGM_P const char*
+#define PSTR(s) (s)
+
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+static inline void* pgm_read_ptr(const void* addr) {
+  void* p;
+  memcpy(&p, addr, sizeof(p));
+  return p;
+}
+#define pgm_read_ptr pgm_read_ptr
+
+#define strcmp_P(a, b) strcmp((a), (b))
+#define strcasecmp_P(a, b) strcasecmp((a), (b))
+#define strncasecmp_P(a, b, n) strncasecmp((a), (b), (n))
+#define strchr_P(s, c) strchr((s), (c))
+#define strlen_P(s) strlen(s)
+
+#endif
@@ -0,0 +1,14 @@
+/******************************************************************************/
+/**  YAFFA - Yet Another Forth for Arduino                                   **/
+/**                                                                          **/
+/**  File: host/sketch.cpp                                                   **/
+/**  Builds the sketch the way the Arduino IDE does: Arduino.h, prototypes   **/
+/**  for every function (generated by the Makefile), then the .ino files in  **/
+/**  order.                                                                  **/
+/**                                                                          **/
+/******************************************************************************/
+#include <Arduino.h>
+#include "../YAFFA.h"
+#include "prototypes.h"
+#include "../YAFFA.ino"
+#include "../Dictionary.ino"
@@ -0,0 +1,56 @@
+#!/bin/sh
+################################################################################
+##  YAFFA - Yet Another Forth for Arduino                                     ##
+##                                                                            ##
+##  File: test/run.sh                                                         ##
+##  Runs each test through the hosted build with test/check.fth ahead of it   ##
+##  and prints one line per test. A test fails if it prints a line starting   ##
+##  with FAIL, see CHECK, or throws. Exits non-zero if any test failed.       ##
+##                                                                            ##
+##    sh test/run.sh [test.fth ...]         (default: every test/*.fth)       ##
+##                                                                            ##
+##  A test may go on in name.2.fth, name.3.fth and so on. Each step runs as   ##
+##  after a reset, with the EEPROM the earlier steps left. A step ending in   ##
+##  .moved.fth runs on YAFFA_MOVED, and is skipped if that is not set.        ##
+##                                                                            ##
+##  YAFFA       - the binary to run (default build/yaffa)                     ##
+##  YAFFA_MOVED - the same build linked with forthSpace at another address    ##
+################################################################################
+YAFFA=${YAFFA:-build/yaffa}
+dir=$(dirname "$0")
+output=${TMPDIR:-/tmp}/yaffa-test.$$
+status=0
+
+[ $# -gt 0 ] ||
+  set -- $(ls "$dir"/*.fth | grep -v -e '/check\.fth$' -e '\.[0-9]')
+
+YAFFA_EEPROM=$output.eeprom
+export YAFFA_EEPROM
+trap 'rm -f "$output" "$YAFFA_EEPROM"' EXIT
+
+for test in "$@"; do
+  name=$(basename "$test" .fth)
+  rm -f "$YAFFA_EEPROM"
+  : > "$output"
+  note=
+  for step in "$test" $(ls "${test%.fth}".[0-9]*.fth 2>/dev/null); do
+    binary=$YAFFA
+    case $step in
+      *.moved.fth)
+        if [ -z "$YAFFA_MOVED" ]; then
+          note=" (moved steps skipped)"
+          continue
+        fi
+        binary=$YAFFA_MOVED ;;
+    esac
+    cat "$dir/check.fth" "$step" | "$binary" | tr -d '\r' >> "$output"
+  done
+  if grep -q -e '^FAIL' -e 'EXCEPTION' "$output"; then
+    printf '%-10s failed\n' "$name"
+    grep -B1 -e '^FAIL' -e 'EXCEPTION' "$output"
+    status=1
+  else
+    printf '%-10s ok%s\n' "$name" "$note"
+  fi
+done
+exit $status